@@ -126,6 +126,7 @@ public class Context : SingletonMonoBehavior<Context>
     public static Difficulty PreferredDifficulty = Difficulty.Easy;
     public static HashSet<Mod> SelectedMods = new HashSet<Mod>();
     public static GameMode SelectedGameMode;
+    public static InputReplay SelectedReplay; // If set, the next game plays back this replay instead of touch input
 
     public static InitializationState InitializationState;
     public static GameState GameState;
@@ -614,7 +615,7 @@ public class Context : SingletonMonoBehavior<Context>
                                 break;
                             case FirstLaunchPhase.BasicTutorial:
                                 // Save the high score, but let's not show the results screen
-                                if (GameState.IsCompleted)
+                                if (GameState.IsCompleted && !GameState.IsPlayback)
                                 {
                                     var record = GameState.Level.Record;
                                     record.IncrementPlayCountByOne(GameState.Difficulty);
@@ -650,7 +651,7 @@ public class Context : SingletonMonoBehavior<Context>
                         var isSpecialGameMode = false;
                         if (TierState != null)
                         {
-                            if (TierState.CurrentStage.IsCompleted)
+                            if (TierState.CurrentStage.IsCompleted && !TierState.CurrentStage.IsPlayback)
                             {
                                 gotoResult = true;
                                 // Show tier break screen
@@ -680,7 +681,7 @@ public class Context : SingletonMonoBehavior<Context>
                                 var usedAuto = GameState.Mods.Contains(Mod.Auto) || GameState.Mods.Contains(Mod.AutoDrag) ||
                                                GameState.Mods.Contains(Mod.AutoHold) ||
                                                GameState.Mods.Contains(Mod.AutoFlick);
-                                if (GameState.IsCompleted &&
+                                if (GameState.IsCompleted && !GameState.IsPlayback &&
                                     (GameState.Mode == GameMode.Standard || GameState.Mode == GameMode.Practice) &&
                                     !usedAuto)
                                 {
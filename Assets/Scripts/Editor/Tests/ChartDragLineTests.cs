@@ -0,0 +1,167 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using NUnit.Framework;
+using UnityEngine;
+using Debug = UnityEngine.Debug;
+
+public class ChartDragLineTests
+{
+    // Three 200-link drag chains, two of them side by side
+    private static string StressChartPath => Application.dataPath + "/Scripts/Editor/Tests/Charts/DragChainStress.json";
+
+    private const float FrameTime = 1 / 60f;
+
+    [Test]
+    public void GetDragLineSegmentIndexAtTime_MatchesLinearScan()
+    {
+        foreach (var chart in new[] {LoadStressChart(), TestCharts.CreateChart(TestCharts.CreateModel(2000))})
+        {
+            foreach (var segment in chart.DragLineSegments)
+            {
+                foreach (var time in new[] {segment.SpawnTime, segment.EndTime - 0.001f, segment.EndTime, segment.EndTime + 0.001f})
+                {
+                    Assert.AreEqual(LinearGetDragLineSegmentIndexAtTime(chart, time),
+                        chart.GetDragLineSegmentIndexAtTime(time), $"Time {time}");
+                }
+            }
+        }
+    }
+
+    [Test]
+    public void Seek_SpawnsExactlyTheSegmentsOnScreen()
+    {
+        var chart = LoadStressChart();
+        var segments = new List<Chart.DragLineSegment>();
+        var endTime = chart.DragLineSegments[chart.DragLineSegments.Length - 1].EndTime + 1;
+        for (var time = 0f; time < endTime; time += 0.25f)
+        {
+            // As PlayerGame.OnSliderSeek followed by Game.Update
+            chart.CurrentDragLineSegmentId = chart.GetDragLineSegmentIndexAtTime(time);
+            segments.Clear();
+            chart.CollectDragLineSegmentsToSpawn(time, segments);
+
+            var expected = new List<int>();
+            foreach (var segment in chart.DragLineSegments)
+            {
+                if (segment.SpawnTime < time && segment.EndTime >= time) expected.Add(segment.FromId);
+            }
+            var actual = segments.ConvertAll(it => it.FromId);
+            expected.Sort();
+            actual.Sort();
+            CollectionAssert.AreEqual(expected, actual, $"Time {time}");
+        }
+    }
+
+    [Test, Category("Benchmark")]
+    public void Benchmark_DragLineSpawning_200LinkChains()
+    {
+        var chart = LoadStressChart();
+        var endTime = chart.DragLineSegments[chart.DragLineSegments.Length - 1].EndTime + 1;
+
+        SimulateChainSpawning(chart, endTime); // Warm up
+        SimulateWindowedSpawning(chart, endTime);
+        var chainResult = SimulateChainSpawning(chart, endTime);
+        var windowResult = SimulateWindowedSpawning(chart, endTime);
+
+        Debug.Log($"Drag lines, 200-link chains at 60 fps: " +
+                  $"whole chain on head spawn: {chainResult}; windowed by segment: {windowResult}");
+        Assert.Less(windowResult.MaxSpawnsPerFrame, chainResult.MaxSpawnsPerFrame);
+        Assert.Less(windowResult.PeakLiveLines, chainResult.PeakLiveLines);
+    }
+
+    // Game.Update before chain segments: spawning a drag head spawned a line for every link of its chain
+    private static SpawnResult SimulateChainSpawning(Chart chart, float endTime)
+    {
+        var notes = chart.Model.note_map;
+        var timings = chart.NoteTimings;
+        var live = new List<float>();
+        var result = new SpawnResult();
+        var stopwatch = new Stopwatch();
+        var currentNoteId = 0;
+        for (var time = 0f; time < endTime; time += FrameTime)
+        {
+            stopwatch.Restart();
+            var spawns = 0;
+            while (currentNoteId < timings.Count && timings.IntroTimes[currentNoteId] - 1f < time)
+            {
+                var note = notes[currentNoteId];
+                if (note.type == (int) NoteType.DragHead || note.type == (int) NoteType.CDragHead)
+                {
+                    while (note.next_id > 0 && chart.Model.HasNote(note.next_id))
+                    {
+                        var next = notes[note.next_id];
+                        live.Add(next.start_time);
+                        spawns++;
+                        note = next;
+                    }
+                }
+                currentNoteId++;
+            }
+            stopwatch.Stop();
+            result.AddFrame(spawns, stopwatch.Elapsed.TotalMilliseconds * 1000, CollectEnded(live, time));
+        }
+        return result;
+    }
+
+    // Game.Update now
+    private static SpawnResult SimulateWindowedSpawning(Chart chart, float endTime)
+    {
+        var segments = new List<Chart.DragLineSegment>();
+        var live = new List<float>();
+        var result = new SpawnResult();
+        var stopwatch = new Stopwatch();
+        chart.CurrentDragLineSegmentId = 0;
+        for (var time = 0f; time < endTime; time += FrameTime)
+        {
+            stopwatch.Restart();
+            segments.Clear();
+            chart.CollectDragLineSegmentsToSpawn(time, segments);
+            foreach (var segment in segments) live.Add(segment.EndTime);
+            stopwatch.Stop();
+            result.AddFrame(segments.Count, stopwatch.Elapsed.TotalMilliseconds * 1000, CollectEnded(live, time));
+        }
+        return result;
+    }
+
+    // Drag lines are collected once their end note is reached; returns the number still live
+    private static int CollectEnded(List<float> liveEndTimes, float time)
+    {
+        liveEndTimes.RemoveAll(it => it < time);
+        return liveEndTimes.Count;
+    }
+
+    private static Chart LoadStressChart() => TestCharts.CreateChart(ChartModelReader.ReadFile(StressChartPath));
+
+    // Chart.GetDragLineSegmentIndexAtTime before the binary search
+    private static int LinearGetDragLineSegmentIndexAtTime(Chart chart, float time)
+    {
+        for (var i = 0; i < chart.DragLineSegments.Length; i++)
+        {
+            if (chart.DragLineSegments[i].EndTime >= time) return i;
+        }
+        return chart.DragLineSegments.Length;
+    }
+
+    private class SpawnResult
+    {
+        public int MaxSpawnsPerFrame;
+        public int PeakLiveLines;
+        public double MaxFrameMicroseconds;
+        private double totalFrameMicroseconds;
+        private int frameCount;
+
+        public void AddFrame(int spawns, double microseconds, int liveLines)
+        {
+            MaxSpawnsPerFrame = Math.Max(MaxSpawnsPerFrame, spawns);
+            PeakLiveLines = Math.Max(PeakLiveLines, liveLines);
+            MaxFrameMicroseconds = Math.Max(MaxFrameMicroseconds, microseconds);
+            totalFrameMicroseconds += microseconds;
+            frameCount++;
+        }
+
+        public override string ToString() =>
+            $"max {MaxSpawnsPerFrame} spawns per frame, peak {PeakLiveLines} live lines, " +
+            $"spawn loop {totalFrameMicroseconds / frameCount:F2} us per frame on average, {MaxFrameMicroseconds:F2} us at most";
+    }
+}
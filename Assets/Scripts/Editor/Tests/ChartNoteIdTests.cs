@@ -0,0 +1,52 @@
+using System;
+using NUnit.Framework;
+
+public class ChartNoteIdTests
+{
+    [Test]
+    public void NegativeNoteId_IsReportedAsChartError()
+    {
+        var model = TestCharts.CreateModel(20, allTypes: false);
+        model.note_list[5].id = -1;
+        var exception = Assert.Catch<Exception>(() => TestCharts.CreateChart(model));
+        StringAssert.Contains("-1", exception.Message);
+    }
+
+    [Test]
+    public void HugeNoteId_IsReportedAsChartError()
+    {
+        var model = TestCharts.CreateModel(20, allTypes: false);
+        model.note_list[5].id = 2000000000;
+        var exception = Assert.Catch<Exception>(() => TestCharts.CreateChart(model));
+        StringAssert.Contains("2000000000", exception.Message);
+    }
+
+    [Test]
+    public void NoteIdGap_IsReportedAsChartError()
+    {
+        var model = TestCharts.CreateModel(20, allTypes: false);
+        for (var i = 10; i < model.note_list.Count; i++) model.note_list[i].id++;
+        var exception = Assert.Catch<Exception>(() => TestCharts.CreateChart(model));
+        StringAssert.Contains("20", exception.Message);
+    }
+
+    [Test]
+    public void DuplicateNoteId_IsReportedAsChartError()
+    {
+        var model = TestCharts.CreateModel(20, allTypes: false);
+        model.note_list[5].id = 4;
+        var exception = Assert.Catch<Exception>(() => TestCharts.CreateChart(model));
+        StringAssert.Contains("Duplicate note id 4", exception.Message);
+    }
+
+    [Test]
+    public void UnorderedNoteList_IsIndexedById()
+    {
+        var model = TestCharts.CreateModel(20, allTypes: false);
+        model.note_list.Reverse();
+        var chart = TestCharts.CreateChart(model);
+
+        Assert.AreEqual(model.note_list.Count, chart.Model.note_map.Length);
+        foreach (var note in model.note_list) Assert.AreSame(note, chart.Model.note_map[note.id]);
+    }
+}
@@ -0,0 +1,48 @@
+using System.Collections.Generic;
+using NUnit.Framework;
+
+public class ChartPageTests
+{
+    [Test]
+    public void GetPageIndexAtTime_MatchesPlaybackAdvance_AtPageBoundaries()
+    {
+        var chart = TestCharts.CreateChart(TestCharts.CreateModel(200, 20));
+        var pages = chart.Model.page_list;
+
+        // Advanced like Game.Update advances CurrentPageId
+        var currentPageId = 0;
+        foreach (var time in GetBoundaryTimes(chart))
+        {
+            while (currentPageId < pages.Count && pages[currentPageId].end_time <= time) currentPageId++;
+            Assert.AreEqual(currentPageId, chart.GetPageIndexAtTime(time), $"Time {time}");
+        }
+    }
+
+    [Test]
+    public void GetScannerPositionY_DoesNotDependOnCursorHistory()
+    {
+        var chart = TestCharts.CreateChart(TestCharts.CreateModel(200, 20));
+        var times = GetBoundaryTimes(chart);
+
+        var forward = new List<float>();
+        foreach (var time in times) forward.Add(chart.GetScannerPositionY(time, false));
+
+        // Seeking backwards takes the binary search path
+        for (var i = times.Count - 1; i >= 0; i--)
+        {
+            Assert.AreEqual(forward[i], chart.GetScannerPositionY(times[i], false), $"Time {times[i]}");
+        }
+    }
+
+    private static List<float> GetBoundaryTimes(Chart chart)
+    {
+        var times = new List<float>();
+        foreach (var page in chart.Model.page_list)
+        {
+            times.Add(page.end_time - 0.001f);
+            times.Add(page.end_time);
+            times.Add(page.end_time + 0.001f);
+        }
+        return times;
+    }
+}
@@ -0,0 +1,133 @@
+using System.Diagnostics;
+using NUnit.Framework;
+using UnityEngine;
+using Debug = UnityEngine.Debug;
+
+public class ChartTempoTests
+{
+    [Test]
+    public void ConvertToTime_MatchesLinearScan_AtSegmentBoundaries()
+    {
+        var model = TestCharts.CreateModel(400, 50);
+        var chart = TestCharts.CreateChart(model);
+
+        foreach (var tempo in model.tempo_list)
+        {
+            foreach (var offset in new[] {-1, -0.01, 0, 0.01, 1})
+            {
+                var tick = (float) (tempo.tick + offset);
+                if (tick < 0) continue;
+                Assert.AreEqual(LinearConvertToTime(model, tick), chart.ConvertToTime(tick), $"Tick {tick}");
+            }
+        }
+    }
+
+    [Test]
+    public void ConvertToTick_MatchesLinearScan_AtSegmentBoundaries()
+    {
+        var model = TestCharts.CreateModel(400, 50);
+        var chart = TestCharts.CreateChart(model);
+
+        foreach (var tempo in model.tempo_list)
+        {
+            var boundary = LinearConvertToTime(model, (float) tempo.tick);
+            foreach (var offset in new[] {-0.01f, -0.0001f, 0, 0.0001f, 0.01f})
+            {
+                var time = boundary + offset;
+                if (time < 0) continue;
+                Assert.AreEqual(LinearConvertToTick(model, time), chart.ConvertToTick(time), $"Time {time}");
+            }
+        }
+    }
+
+    [Test, Category("Benchmark")]
+    public void Benchmark_ChartLoad_5000Notes_500Tempos()
+    {
+        var model = TestCharts.CreateModel(5000, 500);
+        TestCharts.CreateChart(TestCharts.CreateModel(100, 10)); // Warm up
+
+        var stopwatch = Stopwatch.StartNew();
+        var chart = TestCharts.CreateChart(model);
+        var loadTime = stopwatch.Elapsed.TotalMilliseconds;
+
+        // The conversions the chart constructor performs: page start/end, note start/end
+        stopwatch.Restart();
+        var tableSum = 0f;
+        foreach (var page in model.page_list)
+        {
+            tableSum += chart.ConvertToTime((float) page.start_tick) + chart.ConvertToTime((float) page.end_tick);
+        }
+        foreach (var note in model.note_list)
+        {
+            tableSum += chart.ConvertToTime((float) note.tick) +
+                        chart.ConvertToTime((float) (note.tick + note.hold_tick));
+        }
+        var tableTime = stopwatch.Elapsed.TotalMilliseconds;
+
+        stopwatch.Restart();
+        var linearSum = 0f;
+        foreach (var page in model.page_list)
+        {
+            linearSum += LinearConvertToTime(model, (float) page.start_tick) +
+                         LinearConvertToTime(model, (float) page.end_tick);
+        }
+        foreach (var note in model.note_list)
+        {
+            linearSum += LinearConvertToTime(model, (float) note.tick) +
+                         LinearConvertToTime(model, (float) (note.tick + note.hold_tick));
+        }
+        var linearTime = stopwatch.Elapsed.TotalMilliseconds;
+
+        Debug.Log($"Chart load (5000 notes, 500 tempos): {loadTime:F2} ms; " +
+                  $"tick to time conversions: {tableTime:F2} ms with the segment table, " +
+                  $"{linearTime:F2} ms with the linear scan");
+        Assert.AreEqual(linearSum, tableSum);
+    }
+
+    // Chart.ConvertToTime before the segment table
+    private static float LinearConvertToTime(ChartModel model, float tick)
+    {
+        double result = 0;
+
+        var currentTick = 0f;
+        var currentTimeZone = 0;
+
+        for (var i = 1; i < model.tempo_list.Count; i++)
+        {
+            if (model.tempo_list[i].tick >= tick) break;
+            result += (model.tempo_list[i].tick - currentTick) * 1e-6 * model.tempo_list[i - 1].value /
+                      (float) model.time_base;
+            currentTick = (float) model.tempo_list[i].tick;
+            currentTimeZone++;
+        }
+
+        result += (tick - currentTick) * 1e-6 * model.tempo_list[currentTimeZone].value / (float) model.time_base;
+        return (float) result;
+    }
+
+    // Chart.ConvertToTick before the segment table
+    private static int LinearConvertToTick(ChartModel model, float time)
+    {
+        var currentTime = 0.0;
+        var currentTick = 0.0;
+        int i;
+        for (i = 1; i < model.tempo_list.Count; i++)
+        {
+            var delta = (model.tempo_list[i].tick - model.tempo_list[i - 1].tick) / model.time_base *
+                        model.tempo_list[i - 1].value * 1e-6;
+            if (currentTime + delta < time)
+            {
+                currentTime += delta;
+                currentTick = model.tempo_list[i].tick;
+            }
+            else
+            {
+                break;
+            }
+        }
+
+        return Mathf.RoundToInt((float) (currentTick +
+                                         (time - currentTime) / model.tempo_list[i - 1].value * 1e6f *
+                                         model.time_base));
+    }
+}
@@ -0,0 +1,367 @@
+using System;
+using System.Collections;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Reflection;
+using System.Threading;
+using Cytoid.Storyboard;
+using Newtonsoft.Json;
+using Newtonsoft.Json.Linq;
+using NUnit.Framework;
+using Debug = UnityEngine.Debug;
+
+public class CompiledStoryboardTests
+{
+    [Test]
+    public void RoundTrip_PreservesEveryField()
+    {
+        // Every public field of every state type is set, so that each field type of the format is written
+        var random = new TestRandom(1);
+        var storyboard = new Storyboard(null, new JObject());
+        AddObjects<Text, TextState>(storyboard.Texts, random);
+        AddObjects<Sprite, SpriteState>(storyboard.Sprites, random);
+        AddObjects<Video, VideoState>(storyboard.Videos, random);
+        AddObjects<Line, LineState>(storyboard.Lines, random);
+        AddObjects<Controller, ControllerState>(storyboard.Controllers, random);
+        AddObjects<NoteController, NoteControllerState>(storyboard.NoteControllers, random);
+
+        var compiled = CompiledStoryboard.Read(new MemoryStream(Compile(storyboard)));
+
+        AssertObjectsEqual(storyboard.Texts.Values, compiled.Texts);
+        AssertObjectsEqual(storyboard.Sprites.Values, compiled.Sprites);
+        AssertObjectsEqual(storyboard.Videos.Values, compiled.Videos);
+        AssertObjectsEqual(storyboard.Lines.Values, compiled.Lines);
+        AssertObjectsEqual(storyboard.Controllers.Values, compiled.Controllers);
+        AssertObjectsEqual(storyboard.NoteControllers.Values, compiled.NoteControllers);
+    }
+
+    [Test]
+    public void RoundTrip_PreservesNullColorsAndPartialLinePositions()
+    {
+        var storyboard = new Storyboard(null, new JObject());
+        storyboard.Lines["line"] = new Line
+        {
+            Id = "line",
+            States = new List<LineState>
+            {
+                new LineState
+                {
+                    Time = 1,
+                    Pos = new List<LinePosition>
+                    {
+                        new LinePosition {X = new UnitFloat(1, ReferenceUnit.NoteX, false, false)},
+                        new LinePosition
+                        {
+                            Y = new UnitFloat(2, ReferenceUnit.NoteY, true, false),
+                            Z = new UnitFloat(3, ReferenceUnit.World, false, true)
+                        },
+                        new LinePosition()
+                    }
+                },
+                new LineState {Time = 2, Pos = new List<LinePosition>()},
+                new LineState {Time = 3, Pos = null}
+            }
+        };
+        storyboard.Controllers["controller"] = new Controller
+        {
+            Id = "controller",
+            States = new List<ControllerState>
+            {
+                new ControllerState
+                {
+                    Time = 1,
+                    NoteFillColors = new List<Color> {null, new Color {R = 1, G = 2, B = 3, A = 0.5f}, null}
+                },
+                new ControllerState {Time = 2, NoteFillColors = new List<Color>()}
+            }
+        };
+
+        var compiled = CompiledStoryboard.Read(new MemoryStream(Compile(storyboard)));
+
+        AssertObjectsEqual(storyboard.Lines.Values, compiled.Lines);
+        AssertObjectsEqual(storyboard.Controllers.Values, compiled.Controllers);
+        Assert.IsNull(compiled.Lines[0].States[0].Pos[0].Y);
+        Assert.IsNull(compiled.Lines[0].States[2].Pos);
+        Assert.IsNull(compiled.Controllers[0].States[0].NoteFillColors[2]);
+    }
+
+    [Test]
+    public void Read_Truncated_ThrowsInvalidDataException()
+    {
+        var storyboard = new Storyboard(null, new JObject());
+        var random = new TestRandom(2);
+        AddObjects<Sprite, SpriteState>(storyboard.Sprites, random);
+        AddObjects<Line, LineState>(storyboard.Lines, random);
+        AddObjects<Controller, ControllerState>(storyboard.Controllers, random);
+        var data = Compile(storyboard);
+
+        // Every section has to be read, so cutting off any number of bytes must fail
+        var step = Math.Max(1, data.Length / 500);
+        for (var length = 0; length < data.Length; length += step)
+        {
+            Assert.Throws<InvalidDataException>(() => CompiledStoryboard.Read(new MemoryStream(data, 0, length)),
+                $"Length {length} of {data.Length}");
+        }
+        Assert.Throws<InvalidDataException>(() => CompiledStoryboard.Read(new MemoryStream(data, 0, data.Length - 1)));
+
+        var path = Path.GetTempFileName();
+        try
+        {
+            File.WriteAllBytes(path, new ArraySegment<byte>(data, 0, data.Length / 2).ToArray());
+            Assert.IsTrue(CompiledStoryboard.IsCompiled(path));
+            Assert.Throws<InvalidDataException>(() => CompiledStoryboard.Load(path));
+        }
+        finally
+        {
+            File.Delete(path);
+        }
+    }
+
+    [Test, Category("Benchmark")]
+    public void Benchmark_Load_RawJson_CompiledJson_Binary()
+    {
+        var directory = Path.Combine(Path.GetTempPath(), Path.GetRandomFileName());
+        Directory.CreateDirectory(directory);
+        try
+        {
+            var rawPath = Path.Combine(directory, "storyboard.json");
+            File.WriteAllText(rawPath, TestStoryboards.CreateRawStoryboard(2000, 20).ToString(Formatting.None));
+
+            var parsed = LoadRaw(rawPath);
+            var compiledJsonPath = Path.Combine(directory, "storyboard_compiled.json");
+            File.WriteAllText(compiledJsonPath, CompileToJson(parsed).ToString(Formatting.None));
+            var binaryPath = Path.Combine(directory, "storyboard_compiled.bin");
+            File.WriteAllBytes(binaryPath, Compile(parsed));
+            parsed = null;
+
+            // Warm up
+            LoadBinary(binaryPath);
+            LoadRaw(rawPath);
+
+            var binary = MeasureLoad(() => LoadBinary(binaryPath));
+            var compiledJson = MeasureLoad(() => LoadRaw(compiledJsonPath));
+            var raw = MeasureLoad(() => LoadRaw(rawPath));
+
+            Debug.Log("Storyboard load (2000 objects, 20 states each):\n" +
+                      $"raw JSON ({new FileInfo(rawPath).Length / 1024} KB): {raw}\n" +
+                      $"compiled JSON ({new FileInfo(compiledJsonPath).Length / 1024} KB): {compiledJson}\n" +
+                      $"binary ({new FileInfo(binaryPath).Length / 1024} KB): {binary}");
+            Assert.Less(binary.Milliseconds, compiledJson.Milliseconds);
+        }
+        finally
+        {
+            Directory.Delete(directory, true);
+        }
+    }
+
+    private static byte[] Compile(Storyboard storyboard)
+    {
+        using (var stream = new MemoryStream())
+        {
+            storyboard.Compile(stream);
+            return stream.ToArray();
+        }
+    }
+
+    private static Storyboard LoadRaw(string path)
+    {
+        var storyboard = new Storyboard(null, JObject.Parse(File.ReadAllText(path)));
+        storyboard.Parse();
+        return storyboard;
+    }
+
+    private static Storyboard LoadBinary(string path)
+    {
+        var storyboard = new Storyboard(null, CompiledStoryboard.Load(path));
+        storyboard.Parse();
+        return storyboard;
+    }
+
+    // The compiled JSON format written by earlier versions, which Storyboard.Parse still reads
+    private static JObject CompileToJson(Storyboard storyboard)
+    {
+        var serializer = new JsonSerializer {NullValueHandling = NullValueHandling.Ignore};
+        JArray ToArray<TO>(IEnumerable<TO> objects)
+        {
+            var array = new JArray();
+            foreach (var obj in objects) array.Add(JObject.FromObject(obj, serializer));
+            return array;
+        }
+
+        return new JObject
+        {
+            ["compiled"] = true,
+            ["texts"] = ToArray(storyboard.Texts.Values),
+            ["sprites"] = ToArray(storyboard.Sprites.Values),
+            ["videos"] = ToArray(storyboard.Videos.Values),
+            ["lines"] = ToArray(storyboard.Lines.Values),
+            ["controllers"] = ToArray(storyboard.Controllers.Values),
+            ["note_controllers"] = ToArray(storyboard.NoteControllers.Values)
+        };
+    }
+
+    private class LoadMeasurement
+    {
+        public double Milliseconds;
+        public long PeakBytes; // Above the managed heap before loading; sampled, so a lower bound
+        public long RetainedBytes;
+
+        public override string ToString() =>
+            $"{Milliseconds:F0} ms, peak {PeakBytes / (1024 * 1024)} MB, retained {RetainedBytes / (1024 * 1024)} MB";
+    }
+
+    private static LoadMeasurement MeasureLoad(Func<Storyboard> load)
+    {
+        UnitFloat.Storyboard = null; // Would keep the previously loaded storyboard alive
+        var baseline = GC.GetTotalMemory(true);
+        var peak = baseline;
+        var loading = true;
+        var sampler = new Thread(() =>
+        {
+            while (Volatile.Read(ref loading))
+            {
+                peak = Math.Max(peak, GC.GetTotalMemory(false));
+                Thread.Sleep(1);
+            }
+        });
+        sampler.Start();
+
+        var stopwatch = Stopwatch.StartNew();
+        var storyboard = load();
+        var milliseconds = stopwatch.Elapsed.TotalMilliseconds;
+
+        Volatile.Write(ref loading, false);
+        sampler.Join();
+        var retained = GC.GetTotalMemory(true);
+        peak = Math.Max(peak, retained);
+        GC.KeepAlive(storyboard);
+
+        return new LoadMeasurement
+        {
+            Milliseconds = milliseconds,
+            PeakBytes = peak - baseline,
+            RetainedBytes = retained - baseline
+        };
+    }
+
+    private static void AddObjects<TO, TS>(Dictionary<string, TO> objects, TestRandom random)
+        where TO : Object<TS>, new() where TS : ObjectState, new()
+    {
+        for (var i = 0; i < 4; i++)
+        {
+            var obj = new TO
+            {
+                Id = $"{typeof(TO).Name}{i}",
+                TargetId = i % 2 == 0 ? null : "target",
+                ParentId = i % 3 == 0 ? null : $"parent{i}"
+            };
+            // The first state leaves every nullable field unset
+            obj.States.Add(new TS {Time = i});
+            for (var s = 1; s < 4; s++)
+            {
+                var state = new TS();
+                foreach (var field in typeof(TS).GetFields(BindingFlags.Public | BindingFlags.Instance))
+                {
+                    field.SetValue(state, CreateValue(field, random));
+                }
+                obj.States.Add(state);
+            }
+            objects[obj.Id] = obj;
+        }
+    }
+
+    private static object CreateValue(FieldInfo field, TestRandom random)
+    {
+        var type = Nullable.GetUnderlyingType(field.FieldType) ?? field.FieldType;
+        if (type == typeof(float)) return random.Next(100000) / 64f - 500;
+        if (type == typeof(int)) return random.Next(2000) - 1000;
+        if (type == typeof(bool)) return random.Next(2) == 0;
+        if (type.IsEnum)
+        {
+            var values = Enum.GetValues(type);
+            return values.GetValue(random.Next(values.Length));
+        }
+        if (type == typeof(string)) return random.Next(2) == 0 ? "shared" : $"{field.Name}{random.Next(1000)}";
+        if (type == typeof(UnitFloat)) return CreateUnitFloat(random);
+        if (type == typeof(Color)) return CreateColor(random);
+        if (type == typeof(List<LinePosition>))
+        {
+            var positions = new List<LinePosition>();
+            for (var i = random.Next(4); i >= 0; i--)
+            {
+                positions.Add(new LinePosition
+                {
+                    X = random.Next(2) == 0 ? CreateUnitFloat(random) : null,
+                    Y = random.Next(2) == 0 ? CreateUnitFloat(random) : null,
+                    Z = random.Next(2) == 0 ? CreateUnitFloat(random) : null
+                });
+            }
+            return positions;
+        }
+        if (type == typeof(List<Color>))
+        {
+            var colors = new List<Color>();
+            for (var i = random.Next(4); i >= 0; i--) colors.Add(random.Next(3) == 0 ? null : CreateColor(random));
+            return colors;
+        }
+        Assert.Fail($"No test value for {field.DeclaringType.Name}.{field.Name} of type {type.Name}");
+        return null;
+    }
+
+    private static UnitFloat CreateUnitFloat(TestRandom random)
+    {
+        var units = Enum.GetValues(typeof(ReferenceUnit));
+        return new UnitFloat(random.Next(100000) / 64f - 500, (ReferenceUnit) units.GetValue(random.Next(units.Length)),
+            random.Next(2) == 0, random.Next(2) == 0);
+    }
+
+    private static Color CreateColor(TestRandom random)
+    {
+        return new Color {R = random.NextFloat(), G = random.NextFloat(), B = random.NextFloat(), A = random.NextFloat()};
+    }
+
+    private static void AssertObjectsEqual<TO>(ICollection<TO> expected, List<TO> actual) where TO : Cytoid.Storyboard.Object
+    {
+        Assert.AreEqual(expected.Count, actual.Count, $"{typeof(TO).Name} count");
+        var i = 0;
+        foreach (var obj in expected)
+        {
+            AssertValuesEqual(obj, actual[i], $"{typeof(TO).Name}[{i}]");
+            i++;
+        }
+    }
+
+    // Compares public instance fields recursively, including those of the state list, unit floats and colors
+    private static void AssertValuesEqual(object expected, object actual, string path)
+    {
+        if (expected == null || actual == null)
+        {
+            Assert.AreEqual(expected == null, actual == null, $"{path} is null");
+            return;
+        }
+        Assert.AreEqual(expected.GetType(), actual.GetType(), $"{path} type");
+
+        var type = expected.GetType();
+        if (type.IsPrimitive || type.IsEnum || type == typeof(string))
+        {
+            Assert.AreEqual(expected, actual, path);
+        }
+        else if (expected is IList expectedList)
+        {
+            var actualList = (IList) actual;
+            Assert.AreEqual(expectedList.Count, actualList.Count, $"{path} count");
+            for (var i = 0; i < expectedList.Count; i++)
+            {
+                AssertValuesEqual(expectedList[i], actualList[i], $"{path}[{i}]");
+            }
+        }
+        else
+        {
+            foreach (var field in type.GetFields(BindingFlags.Public | BindingFlags.Instance))
+            {
+                AssertValuesEqual(field.GetValue(expected), field.GetValue(actual), $"{path}.{field.Name}");
+            }
+        }
+    }
+}
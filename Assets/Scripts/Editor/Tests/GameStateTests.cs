@@ -0,0 +1,226 @@
+using System;
+using System.Collections.Generic;
+using NUnit.Framework;
+
+public class GameStateTests
+{
+    private const int NoteCount = 600;
+    private const int DifficultyLevel = 15;
+
+    [TestCase(GameMode.Standard, new Mod[0])]
+    [TestCase(GameMode.Standard, new[] {Mod.Hard})]
+    [TestCase(GameMode.Standard, new[] {Mod.ExHard})]
+    [TestCase(GameMode.Standard, new[] {Mod.Hard, Mod.ExHard})]
+    [TestCase(GameMode.Practice, new[] {Mod.Hard})]
+    [TestCase(GameMode.Practice, new[] {Mod.ExHard, Mod.FC})]
+    [TestCase(GameMode.Tier, new Mod[0])]
+    [TestCase(GameMode.Standard, new[] {Mod.AP})]
+    [TestCase(GameMode.Standard, new[] {Mod.FC})]
+    [TestCase(GameMode.Standard, new[] {Mod.Auto})]
+    public void Judge_MatchesModLookup(GameMode mode, Mod[] mods)
+    {
+        AssertMatchesModLookup(mode, mods, state => { });
+    }
+
+    [Test]
+    public void Judge_MatchesModLookup_WhenModsChangeDuringPlay()
+    {
+        AssertMatchesModLookup(GameMode.Standard, new[] {Mod.Hard}, state =>
+        {
+            var judged = state.ClearCount;
+            if (judged == NoteCount / 4) state.SetMod(Mod.ExHard, true);
+            if (judged == NoteCount / 2) state.SetMod(Mod.FC, true);
+            if (judged == NoteCount / 2 + 1) state.SetMod(Mod.FC, false);
+            if (judged == NoteCount * 3 / 4) state.SetMod(Mod.ExHard, false);
+            if (judged == NoteCount * 3 / 4) state.SetMod(Mod.Auto, true);
+        });
+    }
+
+    /**
+     * Judges every note of a chart with random grades, growing more likely to be misses towards the end so that health
+     * passes through the health buffer, and compares the state after each judgement to a reference judge that looks up
+     * the mods through GameState.SelectHpMod and Mods.Contains on every note.
+     */
+    private static void AssertMatchesModLookup(GameMode mode, Mod[] mods, Action<GameState> beforeJudge)
+    {
+        var chart = TestCharts.CreateChart(TestCharts.CreateModel(NoteCount));
+        var state = new GameState(chart, mode, new HashSet<Mod>(mods), DifficultyLevel);
+        var reference = new ReferenceJudge(state);
+        var random = new TestRandom(NoteCount + (int) mode);
+
+        var healthChanged = false;
+        foreach (var note in chart.Model.note_list)
+        {
+            beforeJudge(state);
+
+            var missRate = 0.3f * note.id / NoteCount;
+            var grade = random.NextFloat() < missRate
+                ? random.Next(2) == 0 ? NoteGrade.Miss : NoteGrade.Bad
+                : (NoteGrade) (2 + random.Next(3));
+            var error = (random.NextFloat() - 0.5) * 0.4;
+            var greatGradeWeight = random.NextFloat();
+
+            state.Judge(note.id, (NoteType) note.type, grade, error, greatGradeWeight);
+            reference.Judge((NoteType) note.type, grade, greatGradeWeight);
+
+            var message = $"Note {note.id} ({(NoteType) note.type}, {grade})";
+            Assert.AreEqual(reference.Score, state.Score.Value, 0, message);
+            Assert.AreEqual(reference.Accuracy, state.Accuracy.Value, 0, message);
+            Assert.AreEqual(reference.Combo, state.Combo.Value, message);
+            Assert.AreEqual(reference.MaxCombo, state.MaxCombo.Value, message);
+            Assert.AreEqual(reference.Health, state.Health.Value, 0, message);
+            Assert.AreEqual(reference.ShouldFail, state.ShouldFail, message);
+            Assert.AreEqual(state.Mods.Contains(Mod.Auto), state.HasAutoMod, message);
+            healthChanged |= state.Health.Value != state.MaxHealth.Value;
+        }
+
+        Assert.AreEqual(state.UseHealthSystem, healthChanged, "Health changed");
+    }
+
+    // GameState.Judge before the health change table and the cached mod flags
+    private class ReferenceJudge
+    {
+        public double Score;
+        public double Accuracy;
+        public int Combo;
+        public int MaxCombo;
+        public double Health;
+        public bool ShouldFail;
+
+        private readonly GameState state;
+        private readonly double noteScoreMultiplierFactor;
+        private double noteScoreMultiplier = 1;
+        private double accumulatedAccuracy;
+        private int clearCount;
+        private bool isFullScorePossible = true;
+
+        public ReferenceJudge(GameState state)
+        {
+            this.state = state;
+            noteScoreMultiplierFactor = Math.Sqrt(state.NoteCount) / 3.0;
+            Health = state.MaxHealth;
+        }
+
+        public void Judge(NoteType noteType, NoteGrade grade, double greatGradeWeight)
+        {
+            var mode = state.Mode;
+            var noteCount = state.NoteCount;
+            var maxHealth = state.MaxHealth.Value;
+            clearCount++;
+
+            if (mode == GameMode.Practice)
+            {
+                if (grade != NoteGrade.Perfect && grade != NoteGrade.Great) isFullScorePossible = false;
+            }
+            else
+            {
+                if (grade != NoteGrade.Perfect) isFullScorePossible = false;
+            }
+
+            var miss = grade == NoteGrade.Bad || grade == NoteGrade.Miss;
+            if (miss) Combo = 0;
+            else Combo++;
+            if (Combo > MaxCombo) MaxCombo = Combo;
+
+            if (mode != GameMode.Practice)
+            {
+                switch (grade)
+                {
+                    case NoteGrade.Perfect:
+                        noteScoreMultiplier += 0.004D * noteScoreMultiplierFactor;
+                        break;
+                    case NoteGrade.Great:
+                        noteScoreMultiplier += 0.002D * noteScoreMultiplierFactor;
+                        break;
+                    case NoteGrade.Good:
+                        noteScoreMultiplier += 0.001D * noteScoreMultiplierFactor;
+                        break;
+                    case NoteGrade.Bad:
+                        noteScoreMultiplier -= 0.025D * noteScoreMultiplierFactor;
+                        break;
+                    case NoteGrade.Miss:
+                        noteScoreMultiplier -= 0.05D * noteScoreMultiplierFactor;
+                        break;
+                }
+
+                if (noteScoreMultiplier > 1) noteScoreMultiplier = 1;
+                if (noteScoreMultiplier < 0) noteScoreMultiplier = 0;
+            }
+
+            if (mode == GameMode.Practice)
+            {
+                Score += 900000.0 / noteCount * grade.GetScoreWeight(false) +
+                         100000.0 / (noteCount * (long) (noteCount + 1) / 2.0) * Combo;
+            }
+            else
+            {
+                var maxNoteScore = 1000000.0 / noteCount;
+                double noteScore;
+                if (grade == NoteGrade.Great)
+                {
+                    noteScore = maxNoteScore * (NoteGrade.Great.GetScoreWeight(true) +
+                                                (NoteGrade.Perfect.GetScoreWeight(true) -
+                                                 NoteGrade.Great.GetScoreWeight(true)) *
+                                                greatGradeWeight);
+                }
+                else
+                {
+                    noteScore = maxNoteScore * grade.GetScoreWeight(true);
+                }
+                Score += noteScore * noteScoreMultiplier;
+            }
+
+            if (Score > 999500 && clearCount == noteCount && isFullScorePossible) Score = 1000000;
+            if (Score > 1000000) Score = 1000000;
+            if (Score == 1000000 && !isFullScorePossible) Score = 999999;
+
+            if (mode == GameMode.Practice || grade != NoteGrade.Great)
+            {
+                accumulatedAccuracy += 1.0 * grade.GetAccuracyWeight();
+            }
+            else
+            {
+                accumulatedAccuracy += 1.0 * (NoteGrade.Great.GetAccuracyWeight() +
+                                              (NoteGrade.Perfect.GetAccuracyWeight() -
+                                               NoteGrade.Great.GetAccuracyWeight()) *
+                                              greatGradeWeight);
+            }
+            Accuracy = accumulatedAccuracy / clearCount;
+
+            if (state.UseHealthSystem)
+            {
+                var mod = GameState.SelectHpMod(mode, state.Mods, noteType, grade);
+
+                double change = 0;
+                switch (mod.Type)
+                {
+                    case HpModType.Absolute:
+                        change = mod.Value;
+                        break;
+                    case HpModType.Percentage:
+                        change = mod.Value / 100f * maxHealth;
+                        break;
+                    case HpModType.DivideByNoteCount:
+                        change = mod.Value / noteCount / 100f * maxHealth;
+                        break;
+                }
+
+                if (change < 0 && mod.UseHealthBuffer)
+                {
+                    var healthPercentage = Health / maxHealth;
+                    change *= healthPercentage > 0.3 ? 1 : 0.25 + 2.5 * healthPercentage;
+                }
+
+                Health += change;
+                Health = Math.Min(Math.Max(Health, 0), maxHealth);
+                if (Health <= 0) ShouldFail = true;
+            }
+
+            if (state.Mods.Contains(Mod.AP) && grade != NoteGrade.Perfect ||
+                state.Mods.Contains(Mod.FC) && (grade == NoteGrade.Bad || grade == NoteGrade.Miss))
+            {
+                ShouldFail = true;
+            }
+        }
+    }
+}
@@ -0,0 +1,208 @@
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using NUnit.Framework;
+using Debug = UnityEngine.Debug;
+
+public class HeadlessGameSimulatorTests
+{
+    private const int GoldenNoteCount = 1000;
+    private const int GoldenDifficultyLevel = 15;
+    private const float GoldenMaxError = 0.1f;
+    private const float GoldenMissRate = 0.005f;
+
+    // Expected results of a play of the golden chart and inputs; grade counts are of the judged notes
+    private class Golden
+    {
+        public bool IsFailed;
+        public int ClearCount;
+        public double Score;
+        public double Accuracy;
+        public int MaxCombo;
+        public double Health;
+        public int Perfect, Great, Good, Bad, Miss;
+    }
+
+    [Test]
+    public void Standard_MatchesGolden()
+    {
+        AssertGolden(GameMode.Standard, new Mod[0], new Golden
+        {
+            ClearCount = 1000, Score = 969921.2955468983, Accuracy = 0.9657578523099414, MaxCombo = 589,
+            Health = 1125, Perfect = 894, Great = 77, Good = 26, Bad = 0, Miss = 3
+        });
+    }
+
+    [Test]
+    public void Hard_MatchesGolden()
+    {
+        AssertGolden(GameMode.Standard, new[] {Mod.Hard}, new Golden
+        {
+            ClearCount = 1000, Score = 969921.2955468983, Accuracy = 0.9657578523099414, MaxCombo = 589,
+            Health = 915.1249999999958, Perfect = 894, Great = 77, Good = 26, Bad = 0, Miss = 3
+        });
+    }
+
+    [Test]
+    public void ExHard_MatchesGolden()
+    {
+        // Fails before the end of the chart
+        AssertGolden(GameMode.Standard, new[] {Mod.ExHard}, new Golden
+        {
+            IsFailed = true, ClearCount = 838, Score = 815295.2658716071, Accuracy = 0.9664869251071974,
+            MaxCombo = 589, Health = 0, Perfect = 748, Great = 67, Good = 21, Bad = 0, Miss = 2
+        });
+    }
+
+    [Test]
+    public void Tier_MatchesGolden()
+    {
+        AssertGolden(GameMode.Tier, new Mod[0], new Golden
+        {
+            ClearCount = 1000, Score = 969921.2955468983, Accuracy = 0.9657578523099414, MaxCombo = 589,
+            Health = 132.36253375000615, Perfect = 894, Great = 77, Good = 26, Bad = 0, Miss = 3
+        });
+    }
+
+    [Test]
+    public void Auto_ClearsEveryNoteAsPerfect()
+    {
+        var chart = TestCharts.CreateChart(TestCharts.CreateModel(GoldenNoteCount));
+        var simulator = new HeadlessGameSimulator(chart, GameMode.Standard, new HashSet<Mod> {Mod.Auto},
+            GoldenDifficultyLevel);
+        var state = simulator.Run(new List<SimulatedInput>());
+
+        Assert.IsTrue(state.IsCompleted);
+        Assert.AreEqual(GoldenNoteCount, state.GradeCounts[NoteGrade.Perfect]);
+        Assert.AreEqual(GoldenNoteCount, state.MaxCombo.Value);
+        Assert.AreEqual(1000000, state.Score.Value, 1e-6);
+    }
+
+    [TestCase(30)]
+    [TestCase(60)]
+    [TestCase(120)]
+    [TestCase(240)]
+    public void InputTimingError_AtFrameRate(int frameRate)
+    {
+        var frameDuration = 1f / frameRate;
+        var chart = TestCharts.CreateChart(TestCharts.CreateModel(2000, allTypes: false));
+
+        // Spread over a whole number of frames at every tested frame rate, so that inputs fall uniformly within frames
+        var random = new TestRandom(frameRate);
+        var inputs = new List<SimulatedInput>();
+        foreach (var note in chart.Model.note_list)
+        {
+            var time = note.start_time + (random.NextFloat() - 0.5f) * 4 * InputTiming.MaxPollInterval;
+            inputs.Add(new SimulatedInput(time, note.id, SimulatedInputType.Touch));
+        }
+        HeadlessGameSimulator.SortInputs(inputs);
+
+        var exact = Play(chart, inputs, frameDuration, SimulatedInputTiming.Exact);
+        var frameTime = GetErrorStatistics(Play(chart, inputs, frameDuration, SimulatedInputTiming.FrameTime), exact);
+        var estimated = GetErrorStatistics(Play(chart, inputs, frameDuration, SimulatedInputTiming.Estimated), exact);
+
+        Debug.Log($"Input timing error at {frameRate} fps: frame time {frameTime}; estimated {estimated}");
+
+        // Judging at the frame time is late by half a frame on average
+        Assert.AreEqual(frameDuration / 2, frameTime.Mean, frameDuration * 0.05, "Frame time mean");
+        Assert.Greater(frameTime.Min, -1e-4, "Frame time min");
+
+        // The estimate is unbiased, but still spreads uniformly over half a frame either way
+        Assert.AreEqual(0, estimated.Mean, frameDuration * 0.05, "Estimated mean");
+        Assert.AreEqual(frameDuration / Math.Sqrt(12), estimated.StandardDeviation, frameDuration * 0.03,
+            "Estimated standard deviation");
+        Assert.Less(Math.Max(-estimated.Min, estimated.Max), frameDuration / 2 + 1e-4, "Estimated max");
+    }
+
+    [Test, Category("Benchmark")]
+    public void Benchmark_SimulatorThroughput()
+    {
+        var chart = TestCharts.CreateChart(TestCharts.CreateModel(5000));
+        var inputs = TestCharts.CreateInputs(chart, GoldenMaxError, GoldenMissRate);
+        CreateSimulator(chart).Run(inputs); // Warm up
+
+        const int runs = 5;
+        var frameCount = 0;
+        var stopwatch = Stopwatch.StartNew();
+        for (var i = 0; i < runs; i++)
+        {
+            var simulator = CreateSimulator(chart);
+            simulator.Run(inputs);
+            frameCount += simulator.FrameCount;
+        }
+        var elapsed = stopwatch.Elapsed.TotalMilliseconds;
+
+        Debug.Log($"Headless simulation (5000 notes, 60 fps): {elapsed / runs:F2} ms per play, " +
+                  $"{frameCount / (elapsed / 1000):F0} frames per second, " +
+                  $"{elapsed * 1000 / frameCount:F2} us per frame");
+        Assert.Greater(frameCount, 0);
+    }
+
+    private class ErrorStatistics
+    {
+        public double Mean;
+        public double StandardDeviation;
+        public double Min = double.MaxValue;
+        public double Max = double.MinValue;
+
+        public override string ToString() =>
+            $"mean {Mean * 1000:F2} ms, sd {StandardDeviation * 1000:F2} ms, range [{Min * 1000:F2}, {Max * 1000:F2}] ms";
+    }
+
+    private static GameState Play(Chart chart, List<SimulatedInput> inputs, float frameDuration,
+        SimulatedInputTiming timing)
+    {
+        var simulator = new HeadlessGameSimulator(chart, GameMode.Standard, new HashSet<Mod>(), GoldenDifficultyLevel,
+            frameDuration: frameDuration) {InputTimingMode = timing};
+        return simulator.Run(inputs);
+    }
+
+    // Judgement errors of a play relative to the same inputs judged at their exact times
+    private static ErrorStatistics GetErrorStatistics(GameState state, GameState exact)
+    {
+        var statistics = new ErrorStatistics();
+        var errors = new List<double>();
+        for (var id = 0; id < state.Judgements.Length; id++)
+        {
+            if (!state.Judgements[id].IsJudged) continue;
+            var error = state.Judgements[id].Error - exact.Judgements[id].Error;
+            errors.Add(error);
+            statistics.Min = Math.Min(statistics.Min, error);
+            statistics.Max = Math.Max(statistics.Max, error);
+            statistics.Mean += error;
+        }
+        statistics.Mean /= errors.Count;
+        var sumOfSquares = 0.0;
+        foreach (var error in errors) sumOfSquares += (error - statistics.Mean) * (error - statistics.Mean);
+        statistics.StandardDeviation = Math.Sqrt(sumOfSquares / errors.Count);
+        return statistics;
+    }
+
+    private static HeadlessGameSimulator CreateSimulator(Chart chart) =>
+        new HeadlessGameSimulator(chart, GameMode.Standard, new HashSet<Mod>(), GoldenDifficultyLevel);
+
+    private static void AssertGolden(GameMode mode, Mod[] mods, Golden expected)
+    {
+        var chart = TestCharts.CreateChart(TestCharts.CreateModel(GoldenNoteCount));
+        var simulator = new HeadlessGameSimulator(chart, mode, new HashSet<Mod>(mods), GoldenDifficultyLevel);
+        var state = simulator.Run(TestCharts.CreateInputs(chart, GoldenMaxError, GoldenMissRate));
+
+        var gradeCounts = new int[(int) NoteGrade.Perfect + 1];
+        foreach (var judgement in state.Judgements)
+        {
+            if (judgement.IsJudged) gradeCounts[(int) judgement.Grade]++;
+        }
+
+        Assert.AreEqual(expected.IsFailed, state.IsFailed, "Failed");
+        Assert.AreEqual(expected.ClearCount, state.ClearCount, "Clear count");
+        Assert.AreEqual(expected.Score, state.Score.Value, 1e-6, "Score");
+        Assert.AreEqual(expected.Accuracy, state.Accuracy.Value, 1e-9, "Accuracy");
+        Assert.AreEqual(expected.MaxCombo, state.MaxCombo.Value, "Max combo");
+        Assert.AreEqual(expected.Health, state.Health.Value, 1e-6, "Health");
+        Assert.AreEqual(expected.Perfect, gradeCounts[(int) NoteGrade.Perfect], "Perfect");
+        Assert.AreEqual(expected.Great, gradeCounts[(int) NoteGrade.Great], "Great");
+        Assert.AreEqual(expected.Good, gradeCounts[(int) NoteGrade.Good], "Good");
+        Assert.AreEqual(expected.Bad, gradeCounts[(int) NoteGrade.Bad], "Bad");
+        Assert.AreEqual(expected.Miss, gradeCounts[(int) NoteGrade.Miss], "Miss");
+    }
+}
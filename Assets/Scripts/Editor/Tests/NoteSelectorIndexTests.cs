@@ -0,0 +1,164 @@
+using System.Collections.Generic;
+using Cytoid.Storyboard;
+using NUnit.Framework;
+
+public class NoteSelectorIndexTests
+{
+    private const int NoteCount = 2000;
+
+    [Test]
+    public void Select_NaNAndAbsentX_MatchesLinearScan()
+    {
+        var notes = CreateNotes(1);
+        var index = new NoteSelectorIndex(notes);
+
+        // Absent x is 0; NaN x is never within an x range, not even the default one
+        AssertMatchesLinearScan(notes, index, new NoteSelector {Types = AllTypes()});
+        AssertMatchesLinearScan(notes, index, new NoteSelector {Types = AllTypes(), MinX = 0, MaxX = 0});
+        AssertMatchesLinearScan(notes, index, new NoteSelector {Types = {0}, MinX = -0.01f, MaxX = 0.01f});
+        AssertMatchesLinearScan(notes, index, new NoteSelector {Types = {0}, Start = 100, End = 140});
+        AssertMatchesLinearScan(notes, index,
+            new NoteSelector {Types = {(int) NoteType.Flick}, Start = 0, End = 30, MinX = 0, MaxX = 0});
+    }
+
+    [Test]
+    public void Select_DirectionFilters_MatchLinearScan()
+    {
+        var notes = CreateNotes(2);
+        var index = new NoteSelectorIndex(notes);
+
+        foreach (var direction in new int?[] {null, 1, -1, 0, 2})
+        {
+            AssertMatchesLinearScan(notes, index, new NoteSelector {Types = AllTypes(), Direction = direction});
+            AssertMatchesLinearScan(notes, index,
+                new NoteSelector {Types = {1, 5}, Start = 500, End = 560, Direction = direction});
+            AssertMatchesLinearScan(notes, index,
+                new NoteSelector {Types = {3, 4}, MinX = 0.4f, MaxX = 0.41f, Direction = direction});
+        }
+    }
+
+    [Test]
+    public void Select_TypeAndRangeCombinations_MatchLinearScan()
+    {
+        var notes = CreateNotes(3);
+        var index = new NoteSelectorIndex(notes);
+        var random = new TestRandom(3);
+
+        for (var i = 0; i < 2000; i++)
+        {
+            var selector = new NoteSelector();
+            var typeCount = 1 + random.Next(3);
+            for (var j = 0; j < typeCount; j++) selector.Types.Add(random.Next(9)); // Type 8 is not in the chart
+            if (random.Next(3) > 0)
+            {
+                // Narrow to wide id ranges, reaching past both ends of the chart
+                selector.Start = random.Next(NoteCount + 200) - 100;
+                selector.End = selector.Start + random.Next(random.Next(2) == 0 ? 40 : NoteCount);
+            }
+            if (random.Next(3) > 0)
+            {
+                selector.MinX = random.NextFloat() * 1.2f - 0.1f;
+                selector.MaxX = selector.MinX + random.NextFloat() * (random.Next(2) == 0 ? 0.02f : 1);
+            }
+            if (random.Next(3) == 0) selector.MaxX = selector.MinX; // A single x
+            if (random.Next(4) == 0) selector.Direction = random.Next(2) == 0 ? 1 : -1;
+            AssertMatchesLinearScan(notes, index, selector);
+        }
+    }
+
+    [Test]
+    public void Select_FallbackAndIndexedPaths_MatchLinearScan()
+    {
+        var notes = CreateNotes(4);
+        var index = new NoteSelectorIndex(notes);
+
+        // Selectors covering much of the chart scan the whole note list; narrow ones use the sorted candidates
+        AssertMatchesLinearScan(notes, index, new NoteSelector {Types = AllTypes(), MinX = 0.1f, MaxX = 0.9f});
+        AssertMatchesLinearScan(notes, index, new NoteSelector {Types = {0, 1, 2}, Start = 0, End = NoteCount / 2});
+        AssertMatchesLinearScan(notes, index, new NoteSelector {Types = AllTypes(), Start = 1000, End = 1010});
+        AssertMatchesLinearScan(notes, index, new NoteSelector {Types = AllTypes(), MinX = 0.5f, MaxX = 0.501f});
+        AssertMatchesLinearScan(notes, index, new NoteSelector {Types = AllTypes(), MinX = 0.9f, MaxX = 0.1f});
+    }
+
+    [Test]
+    public void Select_IdenticalSelectors_ShareResult()
+    {
+        var notes = CreateNotes(5);
+        var index = new NoteSelectorIndex(notes);
+
+        var result = index.Select(new NoteSelector {Types = {0, 5}, Start = 10, End = 200});
+        Assert.AreSame(result, index.Select(new NoteSelector {Types = {5, 0}, Start = 10, End = 200}));
+        Assert.AreNotSame(result, index.Select(new NoteSelector {Types = {5, 0}, Start = 10, End = 201}));
+    }
+
+    /**
+     * Notes of every type in an order other than their ids, with clusters of equal x, absent (0) and NaN x, and both
+     * directions.
+     */
+    private static List<ChartModel.Note> CreateNotes(int seed)
+    {
+        var random = new TestRandom(seed);
+        var notes = new List<ChartModel.Note>(NoteCount);
+        for (var id = 0; id < NoteCount; id++)
+        {
+            var note = new ChartModel.Note
+            {
+                id = id,
+                type = random.Next(8),
+                direction = random.Next(2) == 0 ? 1 : -1
+            };
+            switch (random.Next(10))
+            {
+                case 0:
+                    note.x = double.NaN;
+                    break;
+                case 1:
+                    break; // Absent
+                case 2:
+                    note.x = random.Next(5) / 4.0;
+                    break;
+                default:
+                    note.x = random.Next(1001) / 1000.0;
+                    break;
+            }
+            notes.Add(note);
+        }
+        // Swap neighbours, as in charts whose note list is sorted by time rather than id
+        for (var i = 0; i + 1 < NoteCount; i += 2)
+        {
+            if (random.Next(2) == 0) (notes[i], notes[i + 1]) = (notes[i + 1], notes[i]);
+        }
+        return notes;
+    }
+
+    private static HashSet<int> AllTypes() => new HashSet<int> {0, 1, 2, 3, 4, 5, 6, 7};
+
+    private static void AssertMatchesLinearScan(List<ChartModel.Note> notes, NoteSelectorIndex index,
+        NoteSelector selector)
+    {
+        CollectionAssert.AreEqual(LinearScan(notes, selector), index.Select(selector),
+            $"Types {string.Join(",", selector.Types)}, ids {selector.Start} to {selector.End}, " +
+            $"x {selector.MinX} to {selector.MaxX}, direction {selector.Direction}");
+    }
+
+    // Storyboard.SelectNotes before NoteSelectorIndex
+    private static List<int> LinearScan(List<ChartModel.Note> notes, NoteSelector noteSelector)
+    {
+        var noteIds = new List<int>();
+        foreach (var chartNote in notes)
+        {
+            if (noteSelector.Types.Contains(chartNote.type)
+                && noteSelector.Start <= chartNote.id
+                && noteSelector.End >= chartNote.id
+                && noteSelector.MinX <= chartNote.x
+                && noteSelector.MaxX >= chartNote.x)
+            {
+                if (noteSelector.Direction == null || noteSelector.Direction == chartNote.direction)
+                {
+                    noteIds.Add(chartNote.id);
+                }
+            }
+        }
+        return noteIds;
+    }
+}
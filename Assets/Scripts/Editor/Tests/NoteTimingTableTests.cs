@@ -0,0 +1,66 @@
+using System;
+using System.Linq;
+using NUnit.Framework;
+
+public class NoteTimingTableTests
+{
+    private const float FrameDuration = 1 / 60f;
+
+    [Test]
+    public void Table_MatchesNoteMap()
+    {
+        var chart = TestCharts.CreateChart(TestCharts.CreateModel(200));
+        var timings = chart.NoteTimings;
+
+        Assert.AreEqual(chart.Model.note_map.Length, timings.Count);
+        for (var id = 0; id < timings.Count; id++)
+        {
+            var note = chart.Model.note_map[id];
+            Assert.AreEqual(note.start_time, timings.StartTimes[id], $"Note {id}");
+            Assert.AreEqual(note.end_time, timings.EndTimes[id], $"Note {id}");
+            Assert.AreEqual(note.intro_time, timings.IntroTimes[id], $"Note {id}");
+            Assert.AreEqual((NoteType) note.type, timings.Types[id], $"Note {id}");
+            Assert.AreEqual(note.next_id, timings.NextIds[id], $"Note {id}");
+        }
+    }
+
+    [Test]
+    public void SpawnLoop_SpawnsEveryNote()
+    {
+        var model = TestCharts.CreateModel(200);
+        model.note_list.Reverse();
+        var chart = TestCharts.CreateChart(model);
+        var timings = chart.NoteTimings;
+
+        // Same loop as Game.Update
+        var spawnTimes = new float[timings.Count];
+        var currentNoteId = 0;
+        var endTime = chart.Model.note_list.Max(it => it.end_time);
+        for (var time = 0f; time < endTime && currentNoteId < timings.Count; time += FrameDuration)
+        {
+            while (currentNoteId < timings.Count && timings.IntroTimes[currentNoteId] - 1f < time)
+            {
+                spawnTimes[currentNoteId++] = time;
+            }
+        }
+
+        Assert.AreEqual(timings.Count, currentNoteId, "Spawned notes");
+        for (var id = 0; id < timings.Count; id++)
+        {
+            Assert.Less(spawnTimes[id], timings.StartTimes[id], $"Note {id} spawned after its start time");
+        }
+    }
+
+    [Test]
+    public void NoteIdGap_IsRejectedBeforeSpawning()
+    {
+        // A gap used to leave an unused id whose intro time is never reached, which stalled the spawn loop for good
+        var model = TestCharts.CreateModel(200);
+        foreach (var note in model.note_list)
+        {
+            if (note.id >= 100) note.id++;
+            if (note.next_id >= 100) note.next_id++;
+        }
+        Assert.Catch<Exception>(() => TestCharts.CreateChart(model));
+    }
+}
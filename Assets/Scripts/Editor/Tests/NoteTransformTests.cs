@@ -0,0 +1,349 @@
+using System;
+using System.Collections.Generic;
+using NUnit.Framework;
+using UnityEngine;
+using Object = UnityEngine.Object;
+
+/**
+ * Plays a chart frame by frame in two ways and checks that every spawned note ends each frame at the same local
+ * position and rotation:
+ * - a model of the per-note path before NoteUpdateScheduler batched it, where each note computed its rotation from the
+ *   transforms during its own late update;
+ * - a NoteUpdateScheduler driving notes that compute their position and rotation like Note and move like DragHeadNote,
+ *   so that its registration, swap-removal and batched transform write-back are those of the game.
+ * The per-note path updates notes in reverse spawn order, so that a drag head always reads the current rotation of the
+ * links spawned after it. (Game.onGameUpdate invoked them in spawn order, in which a drag head read the rotations of
+ * those links from the previous frame; the batched path does not depend on the order.) Every note is hit exactly at
+ * its start time.
+ */
+public class NoteTransformTests
+{
+    private const float FrameTime = 1 / 60f;
+
+    private readonly List<Playback> playbacks = new List<Playback>();
+
+    private class SimulatedNote
+    {
+        public ChartModel.Note Model;
+        public ChartModel.Note NextNoteModel;
+        public bool IsCleared;
+        public Vector3 LocalPosition;
+
+        // The transform of the note if it is driven by NoteUpdateScheduler, else its simulated position and rotation
+        public Transform Transform;
+        private Vector3 transformPosition;
+        private Vector3 transformRotation;
+
+        // Drag heads only, see DragHeadNote
+        public ChartModel.Note FromNoteModel;
+        public ChartModel.Note ToNoteModel;
+        public ChartModel.Note StartToNoteModel;
+        public ChartModel.Note EndNoteModel;
+
+        public bool IsDragHead => Model.type == (int) NoteType.DragHead || Model.type == (int) NoteType.CDragHead;
+
+        public Vector3 TransformPosition
+        {
+            get => Transform != null ? Transform.localPosition : transformPosition;
+            set
+            {
+                if (Transform != null) Transform.localPosition = value;
+                else transformPosition = value;
+            }
+        }
+
+        public Vector3 TransformRotation
+        {
+            get => transformRotation;
+            set
+            {
+                if (Transform != null) Transform.localEulerAngles = value;
+                transformRotation = value;
+            }
+        }
+    }
+
+    // Computes its position and rotation like Note, and moves like DragHeadNote
+    private class ScheduledNote : Note
+    {
+        public Playback Playback;
+        public SimulatedNote Simulated;
+
+        protected override NoteRenderer CreateRenderer() => null;
+
+        public override bool UpdateLocalPosition()
+        {
+            if (Simulated.IsCleared) return false;
+            LocalPosition = Simulated.LocalPosition = Simulated.Model.CalculatePosition(Playback.Chart);
+            return true;
+        }
+
+        public override Vector3 UpdateRotation()
+        {
+            Vector3? nextPosition = null;
+            if (Simulated.NextNoteModel != null)
+            {
+                nextPosition = Playback.SpawnedNotes.TryGetValue(Simulated.NextNoteModel.id, out var nextNote)
+                    ? nextNote.LocalPosition
+                    : Simulated.NextNoteModel.position;
+            }
+            return Simulated.Model.UpdateRotation(LocalPosition, nextPosition);
+        }
+
+        protected override void OnGameUpdate(Game _)
+        {
+            if (Playback.Time >= Simulated.Model.start_time) Simulated.IsCleared = true;
+        }
+
+        protected override void OnGameLateUpdate(Game _)
+        {
+            if (!Simulated.IsDragHead) return;
+            Playback.MoveDragHead(Simulated, Playback.Time, true);
+            LocalPosition = Simulated.LocalPosition;
+        }
+    }
+
+    private class Playback
+    {
+        public readonly Chart Chart;
+        public readonly NoteUpdateScheduler Scheduler; // Null for the per-note path
+        public readonly List<SimulatedNote> Notes = new List<SimulatedNote>(); // In spawn order
+        public readonly Dictionary<int, SimulatedNote> SpawnedNotes = new Dictionary<int, SimulatedNote>();
+        private readonly Dictionary<SimulatedNote, ScheduledNote> scheduledNotes =
+            new Dictionary<SimulatedNote, ScheduledNote>();
+        public float Time;
+        private int currentNoteId;
+
+        public Playback(Chart chart, NoteUpdateScheduler scheduler)
+        {
+            Chart = chart;
+            Scheduler = scheduler;
+        }
+
+        public void Spawn(float time)
+        {
+            var notes = Chart.Model.note_list;
+            while (currentNoteId < notes.Count && notes[currentNoteId].intro_time - 1f < time)
+            {
+                var model = notes[currentNoteId++];
+                var note = new SimulatedNote
+                {
+                    Model = model,
+                    NextNoteModel = model.next_id > 0 && Chart.Model.HasNote(model.next_id)
+                        ? Chart.Model.note_map[model.next_id]
+                        : null
+                };
+                if (note.IsDragHead)
+                {
+                    note.FromNoteModel = model;
+                    note.ToNoteModel = note.StartToNoteModel = note.NextNoteModel ?? model;
+                    note.EndNoteModel = model.GetDragEndNote(Chart.Model);
+                }
+                if (Scheduler != null)
+                {
+                    var scheduledNote = new GameObject($"Note {model.id}").AddComponent<ScheduledNote>();
+                    scheduledNote.Playback = this;
+                    scheduledNote.Simulated = note;
+                    note.Transform = scheduledNote.transform;
+                    scheduledNotes[note] = scheduledNote;
+                    Scheduler.Add(scheduledNote);
+                }
+                Notes.Add(note);
+                SpawnedNotes[model.id] = note;
+            }
+        }
+
+        public void Collect(float time)
+        {
+            for (var i = Notes.Count - 1; i >= 0; i--)
+            {
+                var note = Notes[i];
+                var canCollect = note.IsDragHead
+                    ? time >= note.EndNoteModel.end_time + NoteType.DragChild.GetDefaultMissThreshold()
+                    : note.IsCleared;
+                if (!canCollect) continue;
+                // Listeners of Game.onGameUpdate kept their order; the scheduler swaps the last note into the slot
+                Notes.RemoveAt(i);
+                SpawnedNotes.Remove(note.Model.id);
+                if (scheduledNotes.TryGetValue(note, out var scheduledNote)) Destroy(scheduledNote);
+            }
+        }
+
+        public void Dispose()
+        {
+            foreach (var scheduledNote in new List<ScheduledNote>(scheduledNotes.Values)) Destroy(scheduledNote);
+        }
+
+        private void Destroy(ScheduledNote scheduledNote)
+        {
+            Scheduler.Remove(scheduledNote);
+            scheduledNotes.Remove(scheduledNote.Simulated);
+            Object.DestroyImmediate(scheduledNote.gameObject);
+        }
+
+        // DragHeadNote.OnGameLateUpdate, without the miss checks
+        public void MoveDragHead(SimulatedNote note, float time, bool updateLocalPosition)
+        {
+            note.TransformRotation = note.FromNoteModel.rotation;
+            if (time < note.Model.start_time)
+            {
+                note.FromNoteModel = note.Model;
+                note.ToNoteModel = note.StartToNoteModel;
+                return;
+            }
+
+            var position = Vector3.Lerp(
+                SpawnedNotes.TryGetValue(note.FromNoteModel.id, out var fromNote) && fromNote != note
+                    ? fromNote.TransformPosition
+                    : note.FromNoteModel.CalculatePosition(Chart),
+                SpawnedNotes.TryGetValue(note.ToNoteModel.id, out var toNote)
+                    ? toNote.TransformPosition
+                    : note.ToNoteModel.CalculatePosition(Chart),
+                (time - note.FromNoteModel.start_time) / (note.ToNoteModel.start_time - note.FromNoteModel.start_time));
+            if (time >= note.ToNoteModel.start_time)
+            {
+                if (note.ToNoteModel == note.EndNoteModel)
+                {
+                    position = SpawnedNotes.TryGetValue(note.ToNoteModel.id, out toNote)
+                        ? toNote.TransformPosition
+                        : note.ToNoteModel.CalculatePosition(Chart);
+                }
+                else
+                {
+                    note.FromNoteModel = note.ToNoteModel;
+                    note.ToNoteModel = Chart.Model.note_map[note.FromNoteModel.next_id];
+                }
+            }
+            note.TransformPosition = position;
+            if (updateLocalPosition) note.LocalPosition = position;
+        }
+    }
+
+    [TearDown]
+    public void TearDown()
+    {
+        playbacks.ForEach(it => it.Dispose());
+        playbacks.Clear();
+    }
+
+    [Test]
+    public void BatchedTransforms_MatchPerNoteUpdates()
+    {
+        var perNote = new Playback(CreateChart(), null);
+        var scheduler = new NoteUpdateScheduler();
+        var batched = new Playback(CreateChart(), scheduler);
+        playbacks.Add(batched);
+
+        var endTime = 0f;
+        foreach (var note in perNote.Chart.Model.note_list) endTime = Math.Max(endTime, note.end_time + 1);
+
+        var frame = 0;
+        for (var time = -2f; time < endTime; time += FrameTime, frame++)
+        {
+            UpdatePerNote(perNote, time);
+            UpdateBatched(batched, time);
+
+            Assert.AreEqual(perNote.Notes.Count, batched.Notes.Count, $"Spawned notes at frame {frame}");
+            Assert.AreEqual(batched.Notes.Count, scheduler.NoteCount, $"Scheduled notes at frame {frame}");
+            for (var i = 0; i < perNote.Notes.Count; i++)
+            {
+                var expected = perNote.Notes[i];
+                var actual = batched.Notes[i];
+                var message = $"Note {expected.Model.id} ({(NoteType) expected.Model.type}) at frame {frame}";
+                AssertEqual(expected.TransformPosition, actual.Transform.localPosition, message + ", position");
+                Assert.Less(Quaternion.Angle(Quaternion.Euler(expected.TransformRotation), actual.Transform.localRotation),
+                    0.01f, message + ", rotation");
+            }
+        }
+
+        Assert.AreEqual(0, scheduler.NoteCount, "Notes left");
+    }
+
+    // Note.OnGameUpdate/OnGameLateUpdate before NoteUpdateScheduler batched the transform updates
+    private static void UpdatePerNote(Playback playback, float time)
+    {
+        playback.Spawn(time);
+        var notes = playback.Notes;
+        for (var i = notes.Count - 1; i >= 0; i--)
+        {
+            var note = notes[i];
+            if (!note.IsCleared) note.TransformPosition = note.Model.CalculatePosition(playback.Chart);
+            if (time >= note.Model.start_time) note.IsCleared = true;
+        }
+        for (var i = notes.Count - 1; i >= 0; i--)
+        {
+            var note = notes[i];
+            var model = note.Model;
+            if (note.NextNoteModel != null)
+            {
+                var position = note.TransformPosition;
+                var nextPosition = playback.SpawnedNotes.TryGetValue(note.NextNoteModel.id, out var nextNote)
+                    ? nextNote.TransformPosition
+                    : note.NextNoteModel.position;
+
+                if (position == nextPosition)
+                    model.rotation = Vector3.zero;
+                else if (Math.Abs(position.y - nextPosition.y) < 0.000001)
+                    model.rotation = new Vector3(0, 0, position.x > nextPosition.x ? 90 : -90);
+                else if (Math.Abs(position.x - nextPosition.x) < 0.000001)
+                    model.rotation = new Vector3(0, 0, position.y > nextPosition.y ? -180 : 0);
+                else
+                    model.rotation = new Vector3(0, 0, -(
+                        Mathf.Atan((nextPosition.x - position.x) /
+                                   (nextPosition.y - position.y)) / Mathf.PI * 180f +
+                        (nextPosition.y > position.y ? 0 : 180)));
+            }
+
+            var rotation = model.rotation;
+            if (model.Override.RotX != null) rotation.x = model.Override.RotX.Value;
+            if (model.Override.RotY != null) rotation.y = model.Override.RotY.Value;
+            if (model.Override.RotZ != null) rotation.z = model.Override.RotZ.Value;
+            note.TransformRotation = model.rotation = rotation;
+
+            if (note.IsDragHead) playback.MoveDragHead(note, time, false);
+        }
+        playback.Collect(time);
+    }
+
+    // Game.Update with NoteUpdateScheduler
+    private static void UpdateBatched(Playback playback, float time)
+    {
+        playback.Time = time;
+        playback.Spawn(time);
+        playback.Scheduler.Update();
+        playback.Scheduler.LateUpdate();
+        playback.Collect(time);
+    }
+
+    // Every note type, with position and rotation overrides on some notes as set by storyboards
+    private static Chart CreateChart()
+    {
+        var chart = TestCharts.CreateChart(TestCharts.CreateModel(400));
+        var random = new TestRandom(7);
+        foreach (var note in chart.Model.note_list)
+        {
+            switch (random.Next(6))
+            {
+                case 0:
+                    note.Override.RotZ = random.Next(360);
+                    break;
+                case 1:
+                    note.Override.XOffset = random.NextFloat() * 0.2f - 0.1f;
+                    note.Override.YMultiplier = 0.5f + random.NextFloat();
+                    break;
+                case 2:
+                    note.Override.X = random.NextFloat() * 4 - 2;
+                    note.Override.RotX = random.Next(90);
+                    break;
+            }
+        }
+        return chart;
+    }
+
+    private static void AssertEqual(Vector3 expected, Vector3 actual, string message)
+    {
+        Assert.AreEqual(expected.x, actual.x, message + " x");
+        Assert.AreEqual(expected.y, actual.y, message + " y");
+        Assert.AreEqual(expected.z, actual.z, message + " z");
+    }
+}
@@ -0,0 +1,168 @@
+using System;
+using System.Collections.Generic;
+using NUnit.Framework;
+using UnityEngine;
+
+public class NoteUpdateSchedulerTests
+{
+    private readonly List<GameObject> gameObjects = new List<GameObject>();
+
+    // Records its updates, and checks that every transform has been written before any of them
+    private class TestNote : Note
+    {
+        public string Name;
+        public List<string> Log;
+        public List<TestNote> Notes;
+        public bool IsFrozen; // Like a cleared note
+        public Vector3 Position;
+        public Vector3 Rotation;
+        public Action<TestNote> OnUpdate; // After logging either update
+
+        protected override NoteRenderer CreateRenderer() => null;
+
+        public override bool UpdateLocalPosition()
+        {
+            if (IsFrozen) return false;
+            LocalPosition = Position;
+            return true;
+        }
+
+        public override Vector3 UpdateRotation() => Rotation;
+
+        protected override void OnGameUpdate(Game _)
+        {
+            foreach (var note in Notes)
+            {
+                if (note.SchedulerIndex < 0 || note.IsFrozen) continue;
+                Assert.AreEqual(note.Position, note.transform.localPosition, $"{note.Name} position in {Name} update");
+            }
+            Log.Add(Name + " update");
+            OnUpdate?.Invoke(this);
+        }
+
+        protected override void OnGameLateUpdate(Game _)
+        {
+            foreach (var note in Notes)
+            {
+                if (note.SchedulerIndex < 0) continue;
+                Assert.Less(Quaternion.Angle(Quaternion.Euler(note.Rotation), note.transform.localRotation), 0.01f,
+                    $"{note.Name} rotation in {Name} late update");
+            }
+            Log.Add(Name + " late update");
+            OnUpdate?.Invoke(this);
+        }
+    }
+
+    [TearDown]
+    public void TearDown()
+    {
+        gameObjects.ForEach(UnityEngine.Object.DestroyImmediate);
+        gameObjects.Clear();
+    }
+
+    [Test]
+    public void AddRemove_SwapsLastNoteIntoSlot()
+    {
+        var scheduler = new NoteUpdateScheduler();
+        var notes = CreateNotes(100, new List<string>());
+        notes.ForEach(scheduler.Add);
+        scheduler.Add(notes[3]); // Already added
+        Assert.AreEqual(100, scheduler.NoteCount);
+        for (var i = 0; i < notes.Count; i++) Assert.AreEqual(i, notes[i].SchedulerIndex, notes[i].Name);
+
+        scheduler.Remove(notes[3]);
+        scheduler.Remove(notes[3]); // Already removed
+        Assert.AreEqual(99, scheduler.NoteCount);
+        Assert.AreEqual(-1, notes[3].SchedulerIndex);
+        Assert.AreEqual(3, notes[99].SchedulerIndex, "Last note");
+
+        scheduler.Remove(notes[99]);
+        scheduler.Remove(notes[98]); // Now the last note
+        Assert.AreEqual(97, scheduler.NoteCount);
+        Assert.AreEqual(-1, notes[98].SchedulerIndex);
+        Assert.AreEqual(-1, notes[99].SchedulerIndex);
+        Assert.AreEqual(3, notes[97].SchedulerIndex, "Last note");
+
+        scheduler.Add(notes[3]);
+        Assert.AreEqual(97, notes[3].SchedulerIndex, "Added again");
+
+        scheduler.Clear();
+        Assert.AreEqual(0, scheduler.NoteCount);
+        notes.ForEach(it => Assert.AreEqual(-1, it.SchedulerIndex, it.Name));
+    }
+
+    [Test]
+    public void Update_WritesTransformsBeforeUpdatingNotes()
+    {
+        var scheduler = new NoteUpdateScheduler();
+        var log = new List<string>();
+        var notes = CreateNotes(3, log);
+        notes.ForEach(scheduler.Add);
+        notes[1].IsFrozen = true;
+        notes[1].transform.localPosition = new Vector3(-1, -1);
+
+        scheduler.Update();
+        scheduler.LateUpdate();
+
+        Assert.AreEqual(new Vector3(-1, -1), notes[1].transform.localPosition, "Cleared notes stay where they are");
+        CollectionAssert.AreEqual(new[]
+        {
+            "Note 2 update", "Note 1 update", "Note 0 update",
+            "Note 2 late update", "Note 1 late update", "Note 0 late update"
+        }, log);
+    }
+
+    [Test]
+    public void Update_RemovalsByNotes_AreDeferred()
+    {
+        var scheduler = new NoteUpdateScheduler();
+        var log = new List<string>();
+        var notes = CreateNotes(6, log);
+        notes.ForEach(scheduler.Add);
+        // Note 5 is updated first: it removes itself, note 4 that has not been updated yet, and note 0 that is then
+        // readded (as a collected note reused from the pool); note 2 removes note 5 again and note 3, already updated
+        notes[5].OnUpdate = it =>
+        {
+            scheduler.Remove(it);
+            scheduler.Remove(notes[4]);
+            scheduler.Remove(notes[0]);
+            scheduler.Add(notes[0]);
+        };
+        notes[2].OnUpdate = it =>
+        {
+            scheduler.Remove(notes[5]);
+            scheduler.Remove(notes[3]);
+        };
+
+        scheduler.Update();
+        CollectionAssert.AreEqual(new[]
+        {
+            "Note 5 update", "Note 4 update", "Note 3 update", "Note 2 update", "Note 1 update", "Note 0 update"
+        }, log, "Every note updated once");
+        Assert.AreEqual(3, scheduler.NoteCount);
+        foreach (var i in new[] {3, 4, 5}) Assert.AreEqual(-1, notes[i].SchedulerIndex, notes[i].Name);
+
+        log.Clear();
+        notes.ForEach(it => it.OnUpdate = null);
+        scheduler.LateUpdate();
+        CollectionAssert.AreEquivalent(new[] {"Note 0 late update", "Note 1 late update", "Note 2 late update"}, log);
+    }
+
+    private List<TestNote> CreateNotes(int count, List<string> log)
+    {
+        var notes = new List<TestNote>();
+        for (var i = 0; i < count; i++)
+        {
+            var gameObject = new GameObject($"Note {i}");
+            gameObjects.Add(gameObject);
+            var note = gameObject.AddComponent<TestNote>();
+            note.Name = gameObject.name;
+            note.Log = log;
+            note.Notes = notes;
+            note.Position = new Vector3(i, i * 2, 0);
+            note.Rotation = new Vector3(0, 0, i * 10);
+            notes.Add(note);
+        }
+        return notes;
+    }
+}
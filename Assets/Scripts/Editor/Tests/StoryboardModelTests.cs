@@ -0,0 +1,102 @@
+using System.Collections.Generic;
+using Cytoid.Storyboard;
+using NUnit.Framework;
+
+public class StoryboardModelTests
+{
+    [Test]
+    public void FindStates_SeeksInBothDirections_MatchesLinearScan()
+    {
+        var random = new TestRandom(1);
+        foreach (var stateCount in new[] {0, 1, 2, 3, 10, 100})
+        {
+            var component = CreateSprite(stateCount, random);
+            var first = component.FirstStateTime;
+            var last = component.LastStateTime;
+            var cursor = 0;
+
+            // To both ends and beyond, back and forth, and onto state times
+            var times = new List<float> {last + 1, first - 1, last, first, last + 1, first, first - 1};
+            if (stateCount > 0)
+            {
+                times.Add(component.States[stateCount / 2].Time);
+                times.Add(component.States[stateCount - 1].Time);
+                times.Add(component.States[0].Time);
+            }
+            foreach (var time in times) AssertMatchesLinearScan(component, time, ref cursor);
+
+            var now = first - 1;
+            for (var i = 0; i < 2000; i++)
+            {
+                // Mostly small steps forward, with small snaps back and seeks anywhere
+                var step = random.Next(20);
+                if (step == 0) now = first - 2 + random.NextFloat() * (last - first + 4);
+                else if (step < 3) now -= random.NextFloat() * 0.5f;
+                else now += random.NextFloat() * 0.5f;
+                AssertMatchesLinearScan(component, now, ref cursor);
+            }
+        }
+    }
+
+    [Test]
+    public void FindStates_OutOfRangeCursor_MatchesLinearScan()
+    {
+        var component = CreateSprite(10, new TestRandom(2));
+        foreach (var initialCursor in new[] {-5, 0, 5, 10, 15})
+        {
+            foreach (var time in new[] {component.FirstStateTime - 1, component.States[4].Time, component.LastStateTime + 1})
+            {
+                var cursor = initialCursor;
+                AssertMatchesLinearScan(component, time, ref cursor);
+            }
+        }
+    }
+
+    /**
+     * A sprite whose states are sorted by time, as by Storyboard.LoadObject, with runs of states at the same time.
+     */
+    private static Sprite CreateSprite(int stateCount, TestRandom random)
+    {
+        var sprite = new Sprite {Id = "sprite"};
+        var time = random.NextFloat() * 10;
+        for (var i = 0; i < stateCount; i++)
+        {
+            sprite.States.Add(new SpriteState {Time = time});
+            if (random.Next(4) > 0) time += random.NextFloat() * 2;
+        }
+        return sprite;
+    }
+
+    private static void AssertMatchesLinearScan(Sprite component, float time, ref int cursor)
+    {
+        LinearScan(component.States, time, out var expectedCurrentState, out var expectedNextState);
+        component.FindStates(time, ref cursor, out var currentState, out var nextState);
+        var message = $"{component.States.Count} states at {time}";
+        Assert.AreSame(expectedCurrentState, currentState, message);
+        Assert.AreSame(expectedNextState, nextState, message);
+    }
+
+    // Object.FindStates before the cursor
+    private static void LinearScan(List<SpriteState> states, float time, out ObjectState currentState,
+        out ObjectState nextState)
+    {
+        if (states.Count == 0)
+        {
+            currentState = null;
+            nextState = null;
+            return;
+        }
+
+        for (var i = 0; i < states.Count; i++)
+        {
+            if (states[i].Time > time)
+            {
+                currentState = i > 0 ? states[i - 1] : null;
+                nextState = states[i];
+                return;
+            }
+        }
+
+        currentState = nextState = states[states.Count - 1];
+    }
+}
@@ -0,0 +1,231 @@
+using System;
+using System.Collections.Generic;
+using Cysharp.Threading.Tasks;
+using Cytoid.Storyboard;
+using Newtonsoft.Json.Linq;
+using NUnit.Framework;
+using UnityEngine;
+using Object = Cytoid.Storyboard.Object;
+
+public class StoryboardRendererTests
+{
+    private const int ObjectCount = 120;
+    private const int FrameCount = 2000;
+
+    private static readonly Type[] Types =
+        {typeof(NoteController), typeof(Text), typeof(Sprite), typeof(Line), typeof(Video), typeof(Controller)};
+
+    [TestCase(1)]
+    [TestCase(2)]
+    [TestCase(3)]
+    [TestCase(4)]
+    [TestCase(5)]
+    public void UpdateRenderers_MatchesUpdatingEveryRenderer(int seed)
+    {
+        var scheduledWorld = new TestWorld();
+        var scheduled = new Storyboard(null, new JObject()).Renderer;
+        AddRenderers(scheduled.ComponentRenderers, scheduled.TypedComponentRenderers, scheduledWorld, seed);
+        var referenceWorld = new TestWorld();
+        var reference = new ReferenceRenderer();
+        AddRenderers(reference.ComponentRenderers, reference.TypedComponentRenderers, referenceWorld, seed);
+
+        var random = new TestRandom(seed);
+        var time = 0f;
+        for (var frame = 0; frame < FrameCount; frame++)
+        {
+            // Mostly forward, with small snaps back like Game.SynchronizeMusic and seeks backwards
+            var step = random.Next(200);
+            if (step == 0) time -= random.NextFloat() * 30;
+            else if (step < 20) time -= random.NextFloat() * 0.05f;
+            else time += random.NextFloat() * 0.4f;
+            time = Math.Max(0, time);
+
+            scheduledWorld.Time = referenceWorld.Time = time;
+            scheduled.UpdateRenderers(time);
+            reference.UpdateRenderers(time);
+
+            var message = $"Frame {frame} at {time}";
+            CollectionAssert.AreEquivalent(reference.ComponentRenderers.Keys, scheduled.ComponentRenderers.Keys, message);
+            CollectionAssert.AreEquivalent(referenceWorld.Values, scheduledWorld.Values, message);
+        }
+
+        Assert.Less(scheduled.ComponentRenderers.Count, ObjectCount, "Destroyed renderers");
+        Assert.Less(scheduledWorld.UpdateCount, referenceWorld.UpdateCount, "Updates");
+    }
+
+    /**
+     * Adds renderers for random objects of every type. Some have a target_id or parent_id, some have a destroy state,
+     * and some have no states at all.
+     */
+    private static void AddRenderers(Dictionary<string, StoryboardComponentRenderer> componentRenderers,
+        Dictionary<Type, List<StoryboardComponentRenderer>> typedComponentRenderers, TestWorld world, int seed)
+    {
+        var random = new TestRandom(seed);
+        foreach (var type in Types) typedComponentRenderers[type] = new List<StoryboardComponentRenderer>();
+        var renderers = new List<TestRenderer>();
+        for (var i = 0; i < ObjectCount; i++)
+        {
+            var type = Types[random.Next(Types.Length)];
+            var component = CreateObject(type, $"{type.Name}_{i}", random);
+            TestRenderer parent = null;
+            if (renderers.Count > 0 && random.Next(4) == 0)
+            {
+                parent = renderers[random.Next(renderers.Count)];
+                if (random.Next(2) == 0) component.TargetId = parent.Component.Id;
+                else component.ParentId = parent.Component.Id;
+            }
+
+            // Same renderers as UpdatesAfterLastState in ControllerRenderer, VideoRenderer and NoteControllerRenderer
+            var renderer = new TestRenderer(component, world,
+                type == typeof(Controller) || type == typeof(Video) || type == typeof(NoteController));
+            if (parent != null)
+            {
+                parent.Children.Add(renderer);
+                renderer.Parent = parent;
+            }
+            componentRenderers[component.Id] = renderer;
+            typedComponentRenderers[type].Add(renderer);
+            renderers.Add(renderer);
+        }
+    }
+
+    private static Object CreateObject(Type type, string id, TestRandom random)
+    {
+        if (type == typeof(NoteController)) return CreateObject<NoteController, NoteControllerState>(id, random);
+        if (type == typeof(Text)) return CreateObject<Text, TextState>(id, random);
+        if (type == typeof(Sprite)) return CreateObject<Sprite, SpriteState>(id, random);
+        if (type == typeof(Line)) return CreateObject<Line, LineState>(id, random);
+        if (type == typeof(Video)) return CreateObject<Video, VideoState>(id, random);
+        return CreateObject<Controller, ControllerState>(id, random);
+    }
+
+    private static TO CreateObject<TO, TS>(string id, TestRandom random)
+        where TO : Object<TS>, new() where TS : ObjectState, new()
+    {
+        var component = new TO {Id = id};
+        var time = random.NextFloat() * 150;
+        var stateCount = random.Next(5);
+        for (var i = 0; i < stateCount; i++)
+        {
+            var destroy = i == stateCount - 1 && random.Next(6) == 0;
+            component.States.Add(new TS {Time = time, Destroy = destroy ? true : (bool?) null});
+            time += random.NextFloat() * 20;
+        }
+        return component;
+    }
+
+    private class TestWorld
+    {
+        public float Time;
+        public int UpdateCount;
+
+        // What the renderers have written, e.g. the value of a transform by the ID of its object
+        public readonly Dictionary<string, float> Values = new Dictionary<string, float>();
+    }
+
+    /**
+     * Writes a value interpolated between its states to the transform of its object, or of its target. Children also
+     * record the value of their parent's transform at the time they are updated, so that the update order matters.
+     */
+    private class TestRenderer : StoryboardComponentRenderer
+    {
+        private readonly TestWorld world;
+        private readonly bool updatesAfterLastState;
+
+        public TestRenderer(Object component, TestWorld world, bool updatesAfterLastState)
+        {
+            Component = component;
+            this.world = world;
+            this.updatesAfterLastState = updatesAfterLastState;
+        }
+
+        public override bool UpdatesAfterLastState => updatesAfterLastState;
+
+        public override Transform Transform => null;
+
+        public override Transform CanvasTransform => null;
+
+        public override Transform WorldTransform => null;
+
+        public override bool IsOnCanvas => false;
+
+        public override UniTask Initialize() => UniTask.CompletedTask;
+
+        public override void Clear() => world.Values[Component.Id + " cleared"] = world.Time;
+
+        public override void Dispose() => world.Values[Component.Id + " disposed"] = world.Time;
+
+        public override void Update(ObjectState fromState, ObjectState toState)
+        {
+            world.UpdateCount++;
+            var value = fromState.Time;
+            if (toState != fromState) value += (world.Time - fromState.Time) / (toState.Time - fromState.Time);
+            if (updatesAfterLastState) world.Values[Component.Id + " updated"] = world.Time;
+            world.Values[GetTransformId(this)] = value;
+            if (Parent != null)
+            {
+                world.Values[Component.Id + " parent"] =
+                    world.Values.TryGetValue(GetTransformId(Parent), out var parentValue) ? parentValue : -1;
+            }
+        }
+
+        private static string GetTransformId(StoryboardComponentRenderer renderer) =>
+            renderer.Component.TargetId ?? renderer.Component.Id;
+    }
+
+    // StoryboardRenderer.OnGameUpdate before the schedule: every renderer is updated every frame, type by type
+    private class ReferenceRenderer
+    {
+        public readonly Dictionary<string, StoryboardComponentRenderer> ComponentRenderers =
+            new Dictionary<string, StoryboardComponentRenderer>();
+
+        public readonly Dictionary<Type, List<StoryboardComponentRenderer>> TypedComponentRenderers =
+            new Dictionary<Type, List<StoryboardComponentRenderer>>();
+
+        public void UpdateRenderers(float time)
+        {
+            var renderersToDestroy = new Dictionary<string, Type>();
+
+            foreach (var type in Types)
+            {
+                foreach (var renderer in TypedComponentRenderers[type])
+                {
+                    renderer.Component.FindStates(time, ref renderer.StateCursor, out var fromState, out var toState);
+
+                    if (fromState == null) continue;
+
+                    if (fromState.Destroy != null && fromState.Destroy.Value)
+                    {
+                        if (renderer.Parent != null && renderer.Component.TargetId != null)
+                        {
+                            renderersToDestroy[renderer.Parent.Component.Id] = renderer.Parent.Component.GetType();
+                            this.ListOf(renderer.Parent).Flatten(it => it.Children).ForEach(it =>
+                            {
+                                renderersToDestroy[it.Component.Id] = it.Component.GetType();
+                            });
+                        }
+                        else
+                        {
+                            renderer.Parent?.Children.Remove(renderer);
+                            this.ListOf(renderer).Flatten(it => it.Children).ForEach(it =>
+                            {
+                                renderersToDestroy[it.Component.Id] = it.Component.GetType();
+                            });
+                        }
+                        continue;
+                    }
+
+                    renderer.Update(fromState, toState);
+                }
+            }
+
+            foreach (var it in renderersToDestroy)
+            {
+                var renderer = ComponentRenderers[it.Key];
+                renderer.Dispose();
+                ComponentRenderers.Remove(it.Key);
+                TypedComponentRenderers[it.Value].Remove(renderer);
+            }
+        }
+    }
+}
@@ -0,0 +1,224 @@
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Linq;
+using System.Reflection;
+using Cytoid.Storyboard;
+using Newtonsoft.Json.Linq;
+using NUnit.Framework;
+using Debug = UnityEngine.Debug;
+
+public class StoryboardTests
+{
+    private const int ObjectCount = 150;
+
+    [Test]
+    public void Parse_NoteReplacement_UsesObjectsOwnNote()
+    {
+        var sprites = new JArray();
+        for (var i = 0; i < ObjectCount; i++)
+        {
+            sprites.Add(new JObject {["id"] = "sprite_$note", ["note"] = i, ["time"] = 0});
+        }
+        var storyboard = Parse(new JObject {["sprites"] = sprites});
+
+        Assert.AreEqual(ObjectCount, storyboard.Sprites.Count);
+        for (var i = 0; i < ObjectCount; i++) Assert.IsTrue(storyboard.Sprites.ContainsKey($"sprite_{i}"), $"sprite_{i}");
+    }
+
+    [Test]
+    public void Parse_NoteReplacement_CarriesOverToObjectsWithoutNote()
+    {
+        var texts = new JArray {new JObject {["id"] = "text_$note", ["note"] = new JArray(5, 7), ["time"] = 0}};
+        var sprites = new JArray {new JObject {["id"] = "first_$note", ["time"] = 0}};
+        for (var i = 1; i < ObjectCount; i++)
+        {
+            // Every 64th object refers to the note of the object before it
+            sprites.Add(i % 64 == 0
+                ? new JObject {["id"] = $"carried_{i}_$note", ["time"] = 0}
+                : new JObject {["id"] = "sprite_$note", ["note"] = i, ["time"] = 0});
+        }
+        var storyboard = Parse(new JObject {["texts"] = texts, ["sprites"] = sprites});
+
+        Assert.IsTrue(storyboard.Texts.ContainsKey("text_7"));
+        Assert.IsTrue(storyboard.Sprites.ContainsKey("first_7"), "Carried over from the texts");
+        Assert.IsTrue(storyboard.Sprites.ContainsKey("carried_64_63"), "Carried over from sprite 63");
+        Assert.IsTrue(storyboard.Sprites.ContainsKey("carried_128_127"), "Carried over from sprite 127");
+    }
+
+    [Test]
+    public void PopulateJObjects_MatchesEagerExpansion()
+    {
+        var storyboard = new Storyboard(null, new JObject());
+        var populate = typeof(Storyboard).GetMethod("PopulateJObjects", BindingFlags.NonPublic | BindingFlags.Instance);
+        var objects = JArray.Parse(@"[
+            {'note': [3, 1, 2], 'time': [4, 2.5], 'relative_time': [0.5, 0.25], 'add_time': [1], 'x': 1,
+                'states': [{'relative_time': [1, 2]}]},
+            {'add_time': [2, 1], 'relative_time': [1, 3, 2], 'time': 5},
+            {'time': [], 'add_time': [0.5], 'note': 4},
+            {'note': [6, 5], 'time': 1},
+            {'note': 7},
+            {'note': [], 'time': [1, 2]},
+            {'time': [], 'x': 2},
+            {'time': 3}
+        ]");
+
+        foreach (var obj in objects.Cast<JObject>())
+        {
+            var json = obj.ToString();
+            // Each populated object is consumed before moving to the next, as by the parser
+            var populatedObjects = ((IEnumerable<JObject>) populate.Invoke(storyboard, new object[] {obj}))
+                .Select(it => it.ToString()).ToList();
+            CollectionAssert.AreEqual(PopulateEagerly(obj).Select(it => it.ToString()).ToList(), populatedObjects, json);
+            Assert.AreEqual(json, obj.ToString(), "Unchanged");
+        }
+    }
+
+    [Test]
+    public void Parse_PopulatedObjects_MatchEagerExpansion()
+    {
+        // At most one time array per object, so that the eagerly populated storyboard has none left to be populated
+        var root = JObject.Parse(@"{
+            'templates': {
+                'fade': {'states': [{'relative_time': [1, 2], 'opacity': 0.5}, {'add_time': [0.5, 0.25]}]}
+            },
+            'sprites': [
+                {'target_id': 'times_$note', 'note': [3, 1, 2], 'time': [4, 2.5],
+                    'states': [{'relative_time': [1, 3, 2], 'x': 1}]},
+                {'id': 'notes_$note', 'note': [6, 4, 5], 'time': 1, 'states': [
+                    {'add_time': [0.5, 1], 'note': [8, 7], 'y': 2},
+                    {'time': [10, 8], 'states': [{'relative_time': [1, 0.5]}, {'add_time': [2]}]},
+                    {'relative_time': 0.75, 'x': 3}
+                ]},
+                {'target_id': 'template_$note', 'note': 9, 'time': [3, 1], 'template': 'fade',
+                    'states': [{'time': [6, 5], 'template': 'fade'}]},
+                {'id': 'plain', 'time': 2, 'states': [{'time': [], 'x': 4}, {'add_time': 1}]}
+            ],
+            'controllers': [
+                {'target_id': 'camera_$note', 'note': [11, 10], 'states': [{'relative_time': [2, 1], 'fov': 50}]}
+            ]
+        }");
+        var storyboard = Parse((JObject) root.DeepClone());
+        var eagerStoryboard = Parse(ExpandEagerly(root));
+
+        AssertObjectsEqual(eagerStoryboard.Sprites.Values, storyboard.Sprites.Values);
+        AssertObjectsEqual(eagerStoryboard.Controllers.Values, storyboard.Controllers.Values);
+        Assert.AreEqual(2 * 3 + 2, storyboard.Sprites.Values.Cast<Cytoid.Storyboard.Object>().Count(it => it.TargetId != null),
+            "Note × time product");
+    }
+
+    [Test, Category("Benchmark")]
+    public void Benchmark_Parse()
+    {
+        var root = TestStoryboards.CreateRawStoryboard(3000, 20);
+        Parse(TestStoryboards.CreateRawStoryboard(100, 20)); // Warm up
+
+        // Parse logs the time of each object category with a BenchmarkTimer
+        var stopwatch = Stopwatch.StartNew();
+        var storyboard = Parse(root);
+        Debug.Log($"Storyboard parse (3000 objects, 20 states each): {stopwatch.Elapsed.TotalMilliseconds:F0} ms");
+
+        Assert.AreEqual(3000, storyboard.Sprites.Count + storyboard.Lines.Count + storyboard.Controllers.Count);
+    }
+
+    // Objects are compared in definition order; ids are only compared if they are not random
+    private static void AssertObjectsEqual<TO>(ICollection<TO> expected, ICollection<TO> actual)
+        where TO : Cytoid.Storyboard.Object
+    {
+        Assert.AreEqual(expected.Count, actual.Count, "Object count");
+        foreach (var (expectedObject, actualObject) in expected.Zip(actual, (a, b) => (a, b)))
+        {
+            var expectedJson = JObject.FromObject(expectedObject);
+            var actualJson = JObject.FromObject(actualObject);
+            if (expectedObject.TargetId != null) expectedJson["Id"] = actualJson["Id"] = null;
+            Assert.IsTrue(JToken.DeepEquals(expectedJson, actualJson), $"Expected {expectedJson}\nBut was {actualJson}");
+        }
+    }
+
+    /**
+     * Populates the objects and states of an unparsed storyboard up front, as Storyboard.PopulateJObjects did before
+     * it populated them lazily. Note selectors need a chart, so only note ids are supported.
+     */
+    private static JObject ExpandEagerly(JObject root)
+    {
+        root = (JObject) root.DeepClone();
+        foreach (var property in root.Properties().ToList())
+        {
+            if (property.Name == "templates")
+            {
+                foreach (var template in property.Value.Children<JProperty>()) ExpandStates((JObject) template.Value);
+            }
+            else
+            {
+                property.Value = ExpandEagerly((JArray) property.Value);
+            }
+        }
+        return root;
+    }
+
+    private static JArray ExpandEagerly(JArray objects)
+    {
+        var expanded = new JArray();
+        foreach (var obj in objects)
+        {
+            foreach (var populatedObject in PopulateEagerly((JObject) obj))
+            {
+                ExpandStates(populatedObject);
+                expanded.Add(populatedObject);
+            }
+        }
+        return expanded;
+    }
+
+    private static void ExpandStates(JObject obj)
+    {
+        if (obj["states"] is JArray states) obj["states"] = ExpandEagerly(states);
+    }
+
+    // Storyboard.PopulateJObjects before it populated objects lazily
+    private static List<JObject> PopulateEagerly(JObject obj)
+    {
+        var timePopulatedObjects = new List<JObject>();
+        foreach (var timeKey in new[] {"relative_time", "add_time", "time"})
+        {
+            var timeToken = obj.SelectToken(timeKey);
+            if (timeToken != null && timeToken.Type == JTokenType.Array)
+                foreach (var time in timeToken.Values())
+                {
+                    var newObj = (JObject) obj.DeepClone();
+                    newObj[timeKey] = time;
+                    timePopulatedObjects.Add(newObj);
+                }
+        }
+        timePopulatedObjects = timePopulatedObjects.Count == 0 ? new List<JObject> {obj} : timePopulatedObjects;
+
+        var populatedObjects = new List<JObject>();
+        foreach (var obj2 in timePopulatedObjects)
+        {
+            var noteSpecifierToken = obj.SelectToken("note");
+            if (noteSpecifierToken != null)
+            {
+                var noteIds = noteSpecifierToken.Type == JTokenType.Array
+                    ? noteSpecifierToken.Values<int>().ToList()
+                    : new List<int> {(int) noteSpecifierToken};
+                foreach (var noteId in noteIds)
+                {
+                    var newObj = (JObject) obj2.DeepClone();
+                    newObj["note"] = noteId;
+                    populatedObjects.Add(newObj);
+                }
+            }
+            else
+            {
+                populatedObjects.Add(obj2);
+            }
+        }
+        return populatedObjects;
+    }
+
+    private static Storyboard Parse(JObject root)
+    {
+        var storyboard = new Storyboard(null, root);
+        storyboard.Parse();
+        return storyboard;
+    }
+}
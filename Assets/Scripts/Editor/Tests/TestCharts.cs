@@ -0,0 +1,159 @@
+using System;
+using System.Collections.Generic;
+
+/**
+ * Deterministic synthetic charts for EditMode tests. Display options are set on the model, so that creating a Chart
+ * does not fall back to the player settings.
+ */
+public static class TestCharts
+{
+    public const int TimeBase = 480;
+    public const int TicksPerNote = 120;
+
+    /**
+     * Creates a chart with noteCount notes spaced TicksPerNote apart over alternating pages of TimeBase ticks and
+     * tempoCount tempo changes spread evenly over it. With allTypes, every note type appears: holds, long holds, flicks,
+     * and drag and C-drag chains of a head and three children. Otherwise all notes are clicks.
+     */
+    public static ChartModel CreateModel(int noteCount, int tempoCount = 1, bool allTypes = true, int seed = 1)
+    {
+        var random = new TestRandom(seed);
+        var model = new ChartModel
+        {
+            time_base = TimeBase,
+            display_boundaries = false,
+            horizontal_margin = 3,
+            vertical_margin = 3,
+            restrict_play_area_aspect_ratio = true,
+            skip_music_on_completion = true
+        };
+
+        var lastTick = (noteCount + 8) * TicksPerNote;
+        for (var i = 0; i < tempoCount; i++)
+        {
+            model.tempo_list.Add(new ChartModel.Tempo
+            {
+                tick = i == 0 ? 0 : lastTick / tempoCount * i + random.Next(TimeBase),
+                value = 300000 + random.Next(700000)
+            });
+        }
+        model.tempo_list.Sort((a, b) => a.tick.CompareTo(b.tick));
+
+        for (var i = 0; i * TimeBase <= lastTick + 4 * TimeBase; i++)
+        {
+            model.page_list.Add(new ChartModel.Page
+            {
+                start_tick = i * TimeBase,
+                end_tick = (i + 1) * TimeBase,
+                scan_line_direction = i % 2 == 0 ? 1 : -1
+            });
+        }
+
+        var tick = 2 * TimeBase;
+        while (model.note_list.Count < noteCount)
+        {
+            var type = allTypes ? (NoteType) random.Next(8) : NoteType.Click;
+            if (type == NoteType.DragChild || type == NoteType.CDragChild) continue; // Only as part of a chain
+
+            if (type == NoteType.DragHead || type == NoteType.CDragHead)
+            {
+                var childType = type == NoteType.DragHead ? NoteType.DragChild : NoteType.CDragChild;
+                var length = Math.Min(4, noteCount - model.note_list.Count);
+                for (var i = 0; i < length; i++)
+                {
+                    var note = AddNote(model, i == 0 ? type : childType, tick + i * TicksPerNote / 2, random);
+                    note.next_id = i < length - 1 ? note.id + 1 : -1;
+                }
+                tick += length * TicksPerNote / 2;
+            }
+            else
+            {
+                var note = AddNote(model, type, tick, random);
+                if (type == NoteType.Hold) note.hold_tick = TimeBase / 2;
+                if (type == NoteType.LongHold) note.hold_tick = TimeBase * 2;
+            }
+            tick += TicksPerNote;
+        }
+
+        return model;
+    }
+
+    public static Chart CreateChart(ChartModel model) => HeadlessGameSimulator.CreateChart(model);
+
+    /**
+     * Inputs with a timing error of up to maxError either way (triangular, centered on the note's start time). A
+     * missRate fraction of notes is never touched, and one in eight holds is released during its second half.
+     */
+    public static List<SimulatedInput> CreateInputs(Chart chart, float maxError, float missRate, int seed = 1)
+    {
+        var random = new TestRandom(seed);
+        var inputs = new List<SimulatedInput>(chart.Model.note_list.Count * 2);
+        foreach (var note in chart.Model.note_list)
+        {
+            if (random.NextFloat() < missRate) continue;
+            var time = note.start_time + (random.NextFloat() + random.NextFloat() - 1) * maxError;
+            switch ((NoteType) note.type)
+            {
+                case NoteType.Hold:
+                case NoteType.LongHold:
+                    inputs.Add(new SimulatedInput(time, note.id, SimulatedInputType.Touch));
+                    var releaseTime = random.Next(8) == 0
+                        ? note.start_time + (note.end_time - note.start_time) * (0.5f + 0.5f * random.NextFloat())
+                        : note.end_time + 0.05f;
+                    inputs.Add(new SimulatedInput(releaseTime, note.id, SimulatedInputType.Release));
+                    break;
+                case NoteType.Flick:
+                    inputs.Add(new SimulatedInput(time - 0.02f, note.id, SimulatedInputType.Touch));
+                    inputs.Add(new SimulatedInput(time, note.id, SimulatedInputType.Flick));
+                    break;
+                default:
+                    inputs.Add(new SimulatedInput(time, note.id, SimulatedInputType.Touch));
+                    break;
+            }
+        }
+        HeadlessGameSimulator.SortInputs(inputs);
+        return inputs;
+    }
+
+    private static ChartModel.Note AddNote(ChartModel model, NoteType type, int tick, TestRandom random)
+    {
+        var note = new ChartModel.Note
+        {
+            id = model.note_list.Count,
+            type = (int) type,
+            tick = tick,
+            page_index = tick / TimeBase,
+            x = random.Next(1001) / 1000.0
+        };
+        model.note_list.Add(note);
+        return note;
+    }
+}
+
+/**
+ * Linear congruential generator, so that generated charts and inputs do not depend on the System.Random
+ * implementation of the runtime.
+ */
+public class TestRandom
+{
+    private ulong state;
+
+    public TestRandom(int seed)
+    {
+        state = (ulong) seed * 6364136223846793005UL + 1442695040888963407UL;
+    }
+
+    /**
+     * Returns an integer in [0, max).
+     */
+    public int Next(int max)
+    {
+        state = state * 6364136223846793005UL + 1442695040888963407UL;
+        return (int) ((state >> 33) % (ulong) max);
+    }
+
+    /**
+     * Returns a float in [0, 1).
+     */
+    public float NextFloat() => Next(1 << 24) / (float) (1 << 24);
+}
@@ -0,0 +1,57 @@
+using Newtonsoft.Json.Linq;
+
+/**
+ * Deterministic synthetic storyboards for EditMode tests.
+ */
+public static class TestStoryboards
+{
+    /**
+     * Creates an unparsed storyboard of objectCount sprites, lines and controllers in turn, each with stateCount
+     * states. None of them refer to notes, so that it can be parsed without a chart.
+     */
+    public static JObject CreateRawStoryboard(int objectCount, int stateCount, int seed = 1)
+    {
+        var random = new TestRandom(seed);
+        var sprites = new JArray();
+        var lines = new JArray();
+        var controllers = new JArray();
+        for (var i = 0; i < objectCount; i++)
+        {
+            var states = new JArray();
+            for (var s = 1; s < stateCount; s++)
+            {
+                var state = new JObject {["time"] = i * 0.01 + s * 0.5, ["easing"] = "easeOutQuad"};
+                switch (i % 3)
+                {
+                    case 0:
+                        state["x"] = random.Next(800) - 400;
+                        state["y"] = random.Next(600) - 300;
+                        state["opacity"] = random.NextFloat();
+                        state["rot_z"] = random.Next(360);
+                        state["color"] = "#" + random.Next(0x1000000).ToString("x6");
+                        break;
+                    case 1:
+                        state["pos"] = new JArray
+                        {
+                            new JObject {["x"] = random.NextFloat(), ["y"] = random.NextFloat()},
+                            new JObject {["x"] = random.NextFloat(), ["y"] = random.NextFloat()}
+                        };
+                        state["width"] = random.NextFloat() * 0.1;
+                        state["opacity"] = random.NextFloat();
+                        break;
+                    default:
+                        state["fov"] = 40 + random.Next(20);
+                        state["bloom"] = random.Next(2) == 0;
+                        state["bloom_intensity"] = random.NextFloat() * 5;
+                        state["note_fill_colors"] = new JArray("#ff0000", null, "#00ff00");
+                        break;
+                }
+                states.Add(state);
+            }
+            var obj = new JObject {["id"] = $"object{i}", ["time"] = i * 0.01, ["states"] = states};
+            if (i % 3 == 0) obj["path"] = "sprite.png";
+            (i % 3 == 0 ? sprites : i % 3 == 1 ? lines : controllers).Add(obj);
+        }
+        return new JObject {["sprites"] = sprites, ["lines"] = lines, ["controllers"] = controllers};
+    }
+}
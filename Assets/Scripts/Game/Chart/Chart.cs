@@ -1,7 +1,6 @@
 ﻿using System;
 using System.Collections.Generic;
 using System.Linq;
-using Newtonsoft.Json;
 using UnityEngine;
 
 public class Chart
@@ -11,6 +10,7 @@ public class Chart
     public int CurrentPageId { get; set; }
     public int CurrentNoteId { get; set; }
     public int CurrentEventId { get; set; }
+    public int CurrentDragLineSegmentId { get; set; }
     
     public float MusicOffset { get; }
     public bool DisplayBoundaries { get; }
@@ -23,11 +23,25 @@ public class Chart
     public bool IsVerticallyInverted { get; }
     public bool UseScannerSmoothing { get; set; }
 
-    public Dictionary<NoteType, int> MaxSamePageNoteCountByType { get; } = new Dictionary<NoteType, int>();
-    public int MaxSamePageNoteCount { get; }
-    public int MaxSamePageNonDragTypeNoteCount { get; }
-    public int MaxSamePageDragTypeNoteCount { get; }
-    public int MaxSamePageHoldTypeNoteCount { get; }
+    // Peak number of notes/drag lines spawned at the same time, from a sweep over their on-screen lifetimes
+    public Dictionary<NoteType, int> MaxConcurrentNoteCountByType { get; } = new Dictionary<NoteType, int>();
+    public int MaxConcurrentDragLineCount { get; private set; }
+
+    public NoteTimingTable NoteTimings { get; private set; }
+
+    // Every link of every drag chain, sorted by spawn time
+    public DragLineSegment[] DragLineSegments { get; private set; }
+
+    // How long before its line starts to be drawn a drag line segment is spawned
+    public const float DragLineSpawnLeadTime = 1f;
+
+    public struct DragLineSegment
+    {
+        public int FromId;
+        public int ToId;
+        public float SpawnTime;
+        public float EndTime; // Start time of the to note, when the line is fully consumed
+    }
     
     private readonly float baseSize;
     private readonly float horizontalRatio;
@@ -35,33 +49,89 @@ public class Chart
     private readonly float verticalRatio;
     private readonly float screenRatio;
 
+    // dragLineSegmentMaxEndTimes[i]: latest end time of DragLineSegments[0..i]
+    private float[] dragLineSegmentMaxEndTimes;
+
+    // Tempo segments: segment i spans [tempoSegmentStartTicks[i], tempoSegmentStartTicks[i + 1])
+    private double[] tempoSegmentStartTicks;
+    private double[] tempoSegmentStartTimes;
+    private double[] tempoSegmentSecondsPerTick;
+
+    // Seeking further than this falls back to a binary search
+    private const int MaxLinearPageCursorSteps = 4;
+
+    // Private page cursors so that screen position queries do not interfere with CurrentPageId
+    private int scannerPageCursor;
+    private int tickPageCursor;
+
+    /**
+     * Creates a chart from a freshly parsed model (e.g. from ChartModelReader) and derives its times and positions.
+     * Apart from reading Context.Player.Settings for display options that the chart does not set, this does not touch
+     * any Unity API, so it can be called off the main thread.
+     */
     public Chart(
-        string text,
+        ChartModel model,
         bool isHorizontallyInverted,
         bool isVerticallyInverted,
         bool useScannerSmoothing,
         bool useExperimentalNoteAr,
         float approachRateMultiplier,
-        float cameraOrthographicSize)
+        float cameraOrthographicSize,
+        float screenAspectRatio) : this(
+        model,
+        isHorizontallyInverted,
+        isVerticallyInverted,
+        useScannerSmoothing,
+        cameraOrthographicSize,
+        screenAspectRatio,
+        true,
+        useExperimentalNoteAr,
+        approachRateMultiplier)
+    {
+    }
+
+    /**
+     * Creates a chart from a model whose derived fields (times, positions, hold lengths, drag line times, etc.)
+     * have already been computed with the same parameters, e.g. one loaded from ChartCache.
+     */
+    public Chart(
+        ChartModel derivedModel,
+        bool isHorizontallyInverted,
+        bool isVerticallyInverted,
+        bool useScannerSmoothing,
+        float cameraOrthographicSize,
+        float screenAspectRatio) : this(
+        derivedModel,
+        isHorizontallyInverted,
+        isVerticallyInverted,
+        useScannerSmoothing,
+        cameraOrthographicSize,
+        screenAspectRatio,
+        false,
+        false,
+        1f)
+    {
+    }
+
+    private Chart(
+        ChartModel model,
+        bool isHorizontallyInverted,
+        bool isVerticallyInverted,
+        bool useScannerSmoothing,
+        float cameraOrthographicSize,
+        float screenAspectRatio,
+        bool deriveModel,
+        bool useExperimentalNoteAr,
+        float approachRateMultiplier)
     {
         IsHorizontallyInverted = isHorizontallyInverted;
         IsVerticallyInverted = isVerticallyInverted;
         UseScannerSmoothing = useScannerSmoothing;
         
         baseSize = cameraOrthographicSize;
-        screenRatio = 1.0f * UnityEngine.Screen.width / UnityEngine.Screen.height;
-        
-        Model = new ChartModel();
-        try
-        {
-            // New format
-            Model = JsonConvert.DeserializeObject<ChartModel>(text);
-        }
-        catch (JsonReaderException)
-        {
-            // Legacy format
-            Model = FromLegacyChart(text);
-        }
+        screenRatio = screenAspectRatio;
+
+        Model = model;
         
         // Cytoid chart parameters
         MusicOffset = (float) Model.music_offset;
@@ -98,6 +168,165 @@ public class Chart
         verticalRatio = 1 - width * (topRatio + bottomRatio) / height + (3 - VerticalMargin) * 0.05f;
         verticalOffset = -(width * (topRatio - (topRatio + bottomRatio) / 2.0f));
 
+        BuildTempoTable();
+        IndexNotes();
+        if (deriveModel) DeriveModel(useExperimentalNoteAr, approachRateMultiplier);
+        NoteTimings = new NoteTimingTable(Model.note_map);
+        BuildDragLineSegments();
+        AnalyzeConcurrency();
+    }
+
+    /**
+     * Note ids index dense arrays (note_map, NoteTimingTable, GameState.Judgements) that are walked in id order, e.g.
+     * by the spawn loop in Game.Update, so the ids of a chart with n notes must be exactly 0 to n - 1.
+     */
+    private void IndexNotes()
+    {
+        var count = Model.note_list.Count;
+        Model.note_map = new ChartModel.Note[count];
+        foreach (var note in Model.note_list)
+        {
+            if (note.id < 0 || note.id >= count)
+            {
+                throw new Exception($"Invalid note id {note.id}: note ids must range from 0 to {count - 1}");
+            }
+            if (Model.note_map[note.id] != null) throw new Exception($"Duplicate note id {note.id}");
+            Model.note_map[note.id] = note;
+        }
+    }
+
+    private void BuildDragLineSegments()
+    {
+        var segments = new List<DragLineSegment>();
+        foreach (var note in Model.note_list)
+        {
+            var type = (NoteType) note.type;
+            if (type != NoteType.DragHead && type != NoteType.DragChild &&
+                type != NoteType.CDragHead && type != NoteType.CDragChild) continue;
+            if (note.next_id <= 0 || !Model.HasNote(note.next_id)) continue;
+            segments.Add(new DragLineSegment
+            {
+                FromId = note.id,
+                ToId = note.next_id,
+                SpawnTime = note.nextdraglinestarttime - DragLineSpawnLeadTime,
+                EndTime = Model.note_map[note.next_id].start_time
+            });
+        }
+        segments.Sort((a, b) =>
+        {
+            var result = a.SpawnTime.CompareTo(b.SpawnTime);
+            return result != 0 ? result : a.FromId.CompareTo(b.FromId);
+        });
+        DragLineSegments = segments.ToArray();
+
+        dragLineSegmentMaxEndTimes = new float[DragLineSegments.Length];
+        var maxEndTime = float.MinValue;
+        for (var i = 0; i < DragLineSegments.Length; i++)
+        {
+            maxEndTime = Math.Max(maxEndTime, DragLineSegments[i].EndTime);
+            dragLineSegmentMaxEndTimes[i] = maxEndTime;
+        }
+    }
+
+    /**
+     * Returns the index of the first drag line segment that is still on screen at the given time, i.e. where
+     * CurrentDragLineSegmentId should resume after a seek.
+     */
+    public int GetDragLineSegmentIndexAtTime(float time)
+    {
+        // The running maximum of the end times is sorted, unlike the end times themselves
+        int low = 0, high = dragLineSegmentMaxEndTimes.Length;
+        while (low < high)
+        {
+            var mid = (low + high) / 2;
+            if (dragLineSegmentMaxEndTimes[mid] >= time) high = mid;
+            else low = mid + 1;
+        }
+        return low;
+    }
+
+    /**
+     * Advances CurrentDragLineSegmentId past the segments due to spawn at the given time, and adds those that have not
+     * ended yet to segments. Segments that ended before the time (e.g. behind the cursor after a seek) are skipped.
+     */
+    public void CollectDragLineSegmentsToSpawn(float time, List<DragLineSegment> segments)
+    {
+        while (CurrentDragLineSegmentId < DragLineSegments.Length &&
+               DragLineSegments[CurrentDragLineSegmentId].SpawnTime < time)
+        {
+            var segment = DragLineSegments[CurrentDragLineSegmentId];
+            if (segment.EndTime >= time) segments.Add(segment);
+            CurrentDragLineSegmentId++;
+        }
+    }
+
+    /**
+     * A note is spawned 1s before its intro time (see Game.Update) and collected once it has been missed at the
+     * latest; a drag head stays until the end of its chain. Drag lines live from their segment's spawn time until
+     * their end note is reached.
+     */
+    private void AnalyzeConcurrency()
+    {
+        var timings = NoteTimings;
+        var noteSweeps = new Dictionary<NoteType, IntervalSweep>();
+        foreach (var type in (NoteType[]) Enum.GetValues(typeof(NoteType)))
+        {
+            noteSweeps[type] = new IntervalSweep();
+        }
+        var dragLineSweep = new IntervalSweep(DragLineSegments.Length);
+        foreach (var segment in DragLineSegments)
+        {
+            dragLineSweep.Add(segment.SpawnTime, segment.EndTime);
+        }
+
+        for (var id = 0; id < timings.Count; id++)
+        {
+            var type = timings.Types[id];
+            var spawnTime = timings.IntroTimes[id] - 1f;
+            var collectTime = timings.EndTimes[id] + type.GetDefaultMissThreshold();
+            if (type == NoteType.DragHead || type == NoteType.CDragHead)
+            {
+                var endId = id;
+                while (timings.NextIds[endId] > 0 && timings.NextIds[endId] < timings.Count)
+                {
+                    endId = timings.NextIds[endId];
+                }
+                var childType = type == NoteType.CDragHead ? NoteType.CDragChild : NoteType.DragChild;
+                collectTime = Math.Max(collectTime, timings.EndTimes[endId] + childType.GetDefaultMissThreshold());
+            }
+            noteSweeps[type].Add(spawnTime, collectTime);
+        }
+
+        foreach (var pair in noteSweeps)
+        {
+            MaxConcurrentNoteCountByType[pair.Key] = pair.Value.GetPeak();
+        }
+        MaxConcurrentDragLineCount = dragLineSweep.GetPeak();
+    }
+
+    /**
+     * Returns the peak number of judgement effects alive at the same time for notes matching the filter, assuming
+     * each note is judged somewhere between the earliest judgement window and its miss threshold, and its effect
+     * lingers for the given duration.
+     */
+    public int GetMaxConcurrentJudgementCount(Predicate<NoteType> filter, float effectDuration)
+    {
+        const float maxEarlyJudgementTime = 0.8f; // Bad window in practice mode
+        var timings = NoteTimings;
+        var sweep = new IntervalSweep();
+        for (var id = 0; id < timings.Count; id++)
+        {
+            if (!filter(timings.Types[id])) continue;
+            sweep.Add(
+                timings.StartTimes[id] - maxEarlyJudgementTime,
+                timings.EndTimes[id] + timings.Types[id].GetDefaultMissThreshold() + effectDuration
+            );
+        }
+        return sweep.GetPeak();
+    }
+
+    private void DeriveModel(bool useExperimentalNoteAr, float approachRateMultiplier)
+    {
         // Convert tick to absolute time
         foreach (var eventOrder in Model.event_order_list) eventOrder.time = ConvertToTime(eventOrder.tick);
 
@@ -118,34 +347,14 @@ public class Chart
                 page.actual_start_time = 0;
             }
 
-            if (isVerticallyInverted) page.scan_line_direction = page.scan_line_direction == 1 ? -1 : 1;
-        }
-
-        var pageNoteCountsByType = new Dictionary<NoteType, int[]>();
-        foreach (var type in (NoteType[]) Enum.GetValues(typeof(NoteType)))
-        {
-            pageNoteCountsByType[type] = new int[Model.page_list.Count];
+            if (IsVerticallyInverted) page.scan_line_direction = page.scan_line_direction == 1 ? -1 : 1;
         }
 
-        var pageNoteCounts = new int[Model.page_list.Count];
-        var pageDragTypeNoteCounts = new int[Model.page_list.Count];
-        var pageNonDragTypeNoteCounts = new int[Model.page_list.Count];
-        var pageHoldTypeNoteCounts = new int[Model.page_list.Count];
         for (var i = 0; i < Model.note_list.Count; i++)
         {
             var note = Model.note_list[i];
             var type = (NoteType) note.type;
-            Model.note_map[note.id] = note;
             var page = Model.page_list[note.page_index];
-            pageNoteCountsByType[(NoteType) note.type][note.page_index]++;
-            pageNoteCounts[note.page_index]++;
-            
-            var isDragType = type == NoteType.DragHead || type == NoteType.DragChild || type == NoteType.CDragChild;
-            var isHoldType = type == NoteType.Hold || type == NoteType.LongHold;
-
-            if (isDragType) pageDragTypeNoteCounts[note.page_index]++;
-            else pageNonDragTypeNoteCounts[note.page_index]++;
-            if (isHoldType) pageHoldTypeNoteCounts[note.page_index]++;
             
             note.direction = page.scan_line_direction;
             var speed = note.page_index == 0 ? 1.0f : CalculateNoteSpeed(note);
@@ -204,15 +413,6 @@ public class Chart
                 note.intro_time = note.start_time - 1.367f / speed;
         }
 
-        foreach (var type in (NoteType[]) Enum.GetValues(typeof(NoteType)))
-        {
-            MaxSamePageNoteCountByType[type] = pageNoteCountsByType[type].Max();
-        }
-        MaxSamePageNoteCount = pageNoteCounts.Max();
-        MaxSamePageDragTypeNoteCount = pageDragTypeNoteCounts.Max();
-        MaxSamePageNonDragTypeNoteCount = pageNonDragTypeNoteCounts.Max();
-        MaxSamePageHoldTypeNoteCount = pageHoldTypeNoteCounts.Max();
-
         foreach (var note in Model.note_list)
             switch ((NoteType) note.type)
             {
@@ -228,7 +428,7 @@ public class Chart
                 case NoteType.DragHead:
                 case NoteType.CDragHead:
                     note.tint = note.direction == 1 ? 0.94f : 1.06f;
-                    if (note.next_id > 0 && Model.note_map.ContainsKey(note.next_id))
+                    if (note.next_id > 0 && Model.HasNote(note.next_id))
                     {
                         note.nextdraglinestarttime = note.intro_time - 0.133f;
                         note.nextdraglinestoptime = Model.note_map[note.next_id].intro_time - 0.132f;
@@ -238,7 +438,7 @@ public class Chart
                 case NoteType.DragChild:
                 case NoteType.CDragChild:
                     note.tint = note.direction == 1 ? 0.94f : 1.06f;
-                    if (note.next_id > 0 && Model.note_map.ContainsKey(note.next_id))
+                    if (note.next_id > 0 && Model.HasNote(note.next_id))
                     {
                         note.nextdraglinestarttime = note.intro_time - 0.133f;
                         note.nextdraglinestoptime = Model.note_map[note.next_id].intro_time - 0.132f;
@@ -251,49 +451,68 @@ public class Chart
             }
     }
 
-    private float ConvertToTime(float tick)
+    private void BuildTempoTable()
     {
-        double result = 0;
+        var count = Model.tempo_list.Count;
+        tempoSegmentStartTicks = new double[count];
+        tempoSegmentStartTimes = new double[count];
+        tempoSegmentSecondsPerTick = new double[count];
 
-        var currentTick = 0f;
-        var currentTimeZone = 0;
-
-        for (var i = 1; i < Model.tempo_list.Count; i++)
+        var currentTick = 0.0;
+        var currentTime = 0.0;
+        for (var i = 0; i < count; i++)
         {
-            if (Model.tempo_list[i].tick >= tick) break;
-            result += (Model.tempo_list[i].tick - currentTick) * 1e-6 * Model.tempo_list[i - 1].value /
-                      (float) Model.time_base;
-            currentTick = (float) Model.tempo_list[i].tick;
-            currentTimeZone++;
-        }
+            if (i > 0)
+            {
+                currentTime += (Model.tempo_list[i].tick - currentTick) * tempoSegmentSecondsPerTick[i - 1];
+                currentTick = (float) Model.tempo_list[i].tick;
+            }
 
-        result += (tick - currentTick) * 1e-6 * Model.tempo_list[currentTimeZone].value / (float) Model.time_base;
-        return (float) result;
+            tempoSegmentStartTicks[i] = currentTick;
+            tempoSegmentStartTimes[i] = currentTime;
+            tempoSegmentSecondsPerTick[i] = 1e-6 * Model.tempo_list[i].value / (float) Model.time_base;
+        }
     }
 
-    private int ConvertToTick(float time)
+    /**
+     * Binary search for the segment containing the given tick or time. A value lying exactly on a segment boundary
+     * belongs to the earlier segment.
+     */
+    private static int FindTempoSegment(double[] segmentStartValues, double value)
     {
-        var currentTime = 0.0;
-        var currentTick = 0.0;
-        int i;
-        for (i = 1; i < Model.tempo_list.Count; i++)
+        var low = 1;
+        var high = segmentStartValues.Length - 1;
+        var result = 0;
+        while (low <= high)
         {
-            var delta = (Model.tempo_list[i].tick - Model.tempo_list[i - 1].tick) / Model.time_base *
-                        Model.tempo_list[i - 1].value * 1e-6;
-            if (currentTime + delta < time)
+            var mid = (low + high) >> 1;
+            if (segmentStartValues[mid] < value)
             {
-                currentTime += delta;
-                currentTick = Model.tempo_list[i].tick;
+                result = mid;
+                low = mid + 1;
             }
             else
             {
-                break;
+                high = mid - 1;
             }
         }
 
-        return Mathf.RoundToInt((float) (currentTick +
-                                         (time - currentTime) / Model.tempo_list[i - 1].value * 1e6f *
-                                         Model.time_base));
+        return result;
+    }
+
+    public float ConvertToTime(float tick)
+    {
+        var segment = FindTempoSegment(tempoSegmentStartTicks, tick);
+        return (float) (tempoSegmentStartTimes[segment] +
+                        (tick - tempoSegmentStartTicks[segment]) * tempoSegmentSecondsPerTick[segment]);
+    }
+
+    public int ConvertToTick(float time)
+    {
+        var segment = FindTempoSegment(tempoSegmentStartTimes, time);
+        return Mathf.RoundToInt((float) (tempoSegmentStartTicks[segment] +
+                                         (time - tempoSegmentStartTimes[segment]) /
+                                         tempoSegmentSecondsPerTick[segment]));
     }
 
     public float CalculateNoteSpeed(ChartModel.Note note)
@@ -343,11 +562,84 @@ public class Chart
                                                     (page.end_tick - page.start_tick)));
     }
 
+    /**
+     * Returns the index of the first page that has not yet ended at the given time, or page_list.Count if all pages
+     * have ended. A page ends at its end time, like Game.Update advances CurrentPageId. This does not mutate
+     * CurrentPageId.
+     */
+    public int GetPageIndexAtTime(float time)
+    {
+        var low = 0;
+        var high = Model.page_list.Count;
+        while (low < high)
+        {
+            var mid = (low + high) >> 1;
+            if (time >= Model.page_list[mid].end_time) low = mid + 1;
+            else high = mid;
+        }
+
+        return low;
+    }
+
+    /**
+     * Returns the index of the first page that has not yet ended at the given tick, or page_list.Count if all pages
+     * have ended. This does not mutate CurrentPageId.
+     */
+    public int GetPageIndexAtTick(float tick)
+    {
+        var low = 0;
+        var high = Model.page_list.Count;
+        while (low < high)
+        {
+            var mid = (low + high) >> 1;
+            if (tick > Model.page_list[mid].end_tick) low = mid + 1;
+            else high = mid;
+        }
+
+        return low;
+    }
+
+    private int SeekPageCursorByTime(ref int cursor, float time)
+    {
+        var pages = Model.page_list;
+        if (cursor > pages.Count || cursor > 0 && time < pages[cursor - 1].end_time)
+        {
+            // Time went backwards
+            return cursor = GetPageIndexAtTime(time);
+        }
+
+        var steps = 0;
+        while (cursor < pages.Count && time >= pages[cursor].end_time)
+        {
+            if (++steps > MaxLinearPageCursorSteps) return cursor = GetPageIndexAtTime(time);
+            cursor++;
+        }
+
+        return cursor;
+    }
+
+    private int SeekPageCursorByTick(ref int cursor, float tick)
+    {
+        var pages = Model.page_list;
+        if (cursor > pages.Count || cursor > 0 && tick <= pages[cursor - 1].end_tick)
+        {
+            // Tick went backwards
+            return cursor = GetPageIndexAtTick(tick);
+        }
+
+        var steps = 0;
+        while (cursor < pages.Count && tick > pages[cursor].end_tick)
+        {
+            if (++steps > MaxLinearPageCursorSteps) return cursor = GetPageIndexAtTick(tick);
+            cursor++;
+        }
+
+        return cursor;
+    }
+
     public float ConvertChartTickToScreenY(float tick)
     {
-        var targetPageId = 0;
-        while (targetPageId < Model.page_list.Count && tick > Model.page_list[targetPageId].end_tick)
-            targetPageId++;
+        var targetPageId = SeekPageCursorByTick(ref tickPageCursor, tick);
 
         if (targetPageId == Model.page_list.Count)
             return (float) (
@@ -369,41 +661,39 @@ public class Chart
 
     public float GetScannerPositionY(float time, bool useScannerSmoothing)
     {
-        CurrentPageId = 0;
-        while (CurrentPageId < Model.page_list.Count && time > Model.page_list[CurrentPageId].end_time)
-            CurrentPageId++;
-        if (CurrentPageId == Model.page_list.Count)
+        var pageId = SeekPageCursorByTime(ref scannerPageCursor, time);
+        if (pageId == Model.page_list.Count)
         {
             if (useScannerSmoothing)
-                return (float) (-verticalRatio * Model.page_list[CurrentPageId - 1].scan_line_direction *
+                return (float) (-verticalRatio * Model.page_list[pageId - 1].scan_line_direction *
                                 (-baseSize + 2.0f *
                                  baseSize *
-                                 (ConvertToTick(time) - Model.page_list[CurrentPageId - 1].end_tick) *
-                                 1.0f / (Model.page_list[CurrentPageId - 1].end_tick -
-                                         Model.page_list[CurrentPageId - 1].start_tick))
+                                 (ConvertToTick(time) - Model.page_list[pageId - 1].end_tick) *
+                                 1.0f / (Model.page_list[pageId - 1].end_tick -
+                                         Model.page_list[pageId - 1].start_tick))
                                 + verticalOffset);
-            return -verticalRatio * Model.page_list[CurrentPageId - 1].scan_line_direction *
+            return -verticalRatio * Model.page_list[pageId - 1].scan_line_direction *
                    (-baseSize + 2.0f *
                     baseSize *
-                    (time - Model.page_list[CurrentPageId - 1].end_time) *
-                    1.0f / (Model.page_list[CurrentPageId - 1].end_time -
-                            Model.page_list[CurrentPageId - 1].start_time))
+                    (time - Model.page_list[pageId - 1].end_time) *
+                    1.0f / (Model.page_list[pageId - 1].end_time -
+                            Model.page_list[pageId - 1].start_time))
                    + verticalOffset;
         }
 
         if (useScannerSmoothing)
-            return (float) (verticalRatio * Model.page_list[CurrentPageId].scan_line_direction *
+            return (float) (verticalRatio * Model.page_list[pageId].scan_line_direction *
                             (-baseSize + 2.0f *
                              baseSize *
-                             (ConvertToTick(time) - Model.page_list[CurrentPageId].start_tick) *
-                             1.0f / (Model.page_list[CurrentPageId].end_tick -
-                                     Model.page_list[CurrentPageId].start_tick))
+                             (ConvertToTick(time) - Model.page_list[pageId].start_tick) *
+                             1.0f / (Model.page_list[pageId].end_tick -
+                                     Model.page_list[pageId].start_tick))
                             + verticalOffset);
-        return verticalRatio * Model.page_list[CurrentPageId].scan_line_direction *
+        return verticalRatio * Model.page_list[pageId].scan_line_direction *
                (-baseSize + 2.0f *
                 baseSize *
-                (time - Model.page_list[CurrentPageId].start_time) *
-                1.0f / (Model.page_list[CurrentPageId].end_time - Model.page_list[CurrentPageId].start_time))
+                (time - Model.page_list[pageId].start_time) *
+                1.0f / (Model.page_list[pageId].end_time - Model.page_list[pageId].start_time))
                + verticalOffset;
     }
 
@@ -419,7 +709,7 @@ public class Chart
                + verticalOffset;
     }
 
-    public ChartModel FromLegacyChart(string text)
+    public static ChartModel FromLegacyChart(string text)
     {
         // Parse
 
@@ -0,0 +1,402 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Security.Cryptography;
+using UnityEngine;
+
+/**
+ * Binary cache of a fully derived chart model, stored alongside the chart file.
+ *
+ * The cache is keyed by the chart file contents and every parameter that affects derivation (flip mods, approach
+ * rate, screen size, play area margins, etc.), so loading it skips both JSON parsing and derivation in the Chart
+ * constructor. Any mismatch or read error falls back to the JSON path.
+ */
+public static class ChartCache
+{
+    private const int Magic = 0x43435943; // "CYCC"
+    // The key covers the chart and the derivation parameters, but not the code: bump this whenever the cache format or
+    // the derivation in the Chart constructor changes, or caches written by older builds are loaded as they are
+    private const int Version = 2;
+
+    public static string GetCachePath(string chartPath)
+    {
+        return Path.ChangeExtension(chartPath, "chart.bin");
+    }
+
+    public static byte[] CreateKey(
+        string chartPath,
+        bool isHorizontallyInverted,
+        bool isVerticallyInverted,
+        bool useExperimentalNoteAr,
+        float approachRateMultiplier,
+        float cameraOrthographicSize,
+        int screenWidth,
+        int screenHeight)
+    {
+        using (var sha1 = SHA1.Create())
+        using (var stream = new MemoryStream())
+        using (var writer = new BinaryWriter(stream))
+        {
+            var settings = Context.Player.Settings;
+            using (var chartStream = new FileStream(chartPath, FileMode.Open, FileAccess.Read, FileShare.Read, 64 * 1024))
+            {
+                writer.Write(sha1.ComputeHash(chartStream));
+            }
+            writer.Write(isHorizontallyInverted);
+            writer.Write(isVerticallyInverted);
+            writer.Write(useExperimentalNoteAr);
+            writer.Write(approachRateMultiplier);
+            writer.Write(cameraOrthographicSize);
+            writer.Write(screenWidth);
+            writer.Write(screenHeight);
+            writer.Write(settings.HorizontalMargin);
+            writer.Write(settings.VerticalMargin);
+            writer.Write(settings.RestrictPlayAreaAspectRatio);
+            writer.Flush();
+            return sha1.ComputeHash(stream.ToArray());
+        }
+    }
+
+    /**
+     * Returns the cached derived model, or null if the cache does not exist, is outdated or does not match the key.
+     */
+    public static ChartModel TryLoad(string path, byte[] key)
+    {
+        if (!File.Exists(path)) return null;
+        try
+        {
+            using (var reader = new BinaryReader(new MemoryStream(File.ReadAllBytes(path))))
+            {
+                if (reader.ReadInt32() != Magic || reader.ReadInt32() != Version) return null;
+                var storedKey = reader.ReadBytes(reader.ReadInt32());
+                if (!KeyEquals(storedKey, key)) return null;
+                return Read(reader);
+            }
+        }
+        catch (Exception e)
+        {
+            Debug.LogWarning($"Could not read chart cache {path}");
+            Debug.LogWarning(e);
+            return null;
+        }
+    }
+
+    public static void Save(string path, byte[] key, ChartModel model)
+    {
+        var tmpPath = path + ".tmp";
+        try
+        {
+            using (var writer = new BinaryWriter(File.Create(tmpPath)))
+            {
+                writer.Write(Magic);
+                writer.Write(Version);
+                writer.Write(key.Length);
+                writer.Write(key);
+                Write(writer, model);
+            }
+
+            if (File.Exists(path)) File.Delete(path);
+            File.Move(tmpPath, path);
+        }
+        catch (Exception e)
+        {
+            Debug.LogWarning($"Could not write chart cache {path}");
+            Debug.LogWarning(e);
+            try
+            {
+                if (File.Exists(tmpPath)) File.Delete(tmpPath);
+            }
+            catch
+            {
+                // Ignored
+            }
+        }
+    }
+
+    private static bool KeyEquals(byte[] a, byte[] b)
+    {
+        if (a.Length != b.Length) return false;
+        for (var i = 0; i < a.Length; i++)
+        {
+            if (a[i] != b[i]) return false;
+        }
+
+        return true;
+    }
+
+    private static void Write(BinaryWriter writer, ChartModel model)
+    {
+        // String table
+        var strings = new List<string>();
+        var stringIndices = new Dictionary<string, int>();
+
+        int StringIndex(string value)
+        {
+            if (value == null) return -1;
+            if (stringIndices.TryGetValue(value, out var index)) return index;
+            stringIndices[value] = strings.Count;
+            strings.Add(value);
+            return strings.Count - 1;
+        }
+
+        var ringColor = StringIndex(model.ring_color);
+        var fillColors = model.fill_colors == null ? null : Array.ConvertAll(model.fill_colors, StringIndex);
+        model.note_list.ForEach(it =>
+        {
+            StringIndex(it.ring_color);
+            StringIndex(it.fill_color);
+        });
+        model.event_order_list.ForEach(it => it.event_list?.ForEach(e => StringIndex(e.args)));
+
+        writer.Write(strings.Count);
+        strings.ForEach(writer.Write);
+
+        // Chart parameters
+        writer.Write(model.time_base);
+        writer.Write(model.music_offset);
+        writer.Write(model.size);
+        writer.Write(model.opacity);
+        writer.Write(ringColor);
+        writer.Write(fillColors?.Length ?? -1);
+        if (fillColors != null) Array.ForEach(fillColors, writer.Write);
+        WriteNullable(writer, model.display_boundaries);
+        WriteNullable(writer, model.display_background);
+        WriteNullable(writer, model.horizontal_margin);
+        WriteNullable(writer, model.vertical_margin);
+        WriteNullable(writer, model.restrict_play_area_aspect_ratio);
+        WriteNullable(writer, model.skip_music_on_completion);
+
+        writer.Write(model.tempo_list.Count);
+        foreach (var tempo in model.tempo_list)
+        {
+            writer.Write(tempo.tick);
+            writer.Write(tempo.value);
+        }
+
+        writer.Write(model.page_list.Count);
+        foreach (var page in model.page_list)
+        {
+            writer.Write(page.start_tick);
+            writer.Write(page.end_tick);
+            writer.Write(page.scan_line_direction);
+            writer.Write(page.start_time);
+            writer.Write(page.end_time);
+            writer.Write(page.actual_start_tick);
+            writer.Write(page.actual_start_time);
+        }
+
+        writer.Write(model.event_order_list.Count);
+        foreach (var eventOrder in model.event_order_list)
+        {
+            writer.Write(eventOrder.tick);
+            writer.Write(eventOrder.time);
+            writer.Write(eventOrder.event_list?.Count ?? -1);
+            if (eventOrder.event_list == null) continue;
+            foreach (var chartEvent in eventOrder.event_list)
+            {
+                writer.Write(chartEvent.type);
+                writer.Write(StringIndex(chartEvent.args));
+            }
+        }
+
+        writer.Write(model.note_list.Count);
+        foreach (var note in model.note_list)
+        {
+            writer.Write(note.page_index);
+            writer.Write(note.type);
+            writer.Write(note.id);
+            writer.Write(note.tick);
+            writer.Write(note.x);
+            writer.Write(note.has_sibling);
+            writer.Write(note.hold_tick);
+            writer.Write(note.next_id);
+            writer.Write(note.is_forward);
+            writer.Write(note.approach_rate);
+            writer.Write(note.size);
+            writer.Write(note.opacity);
+            writer.Write(note.hitbox);
+            writer.Write(StringIndex(note.ring_color));
+            writer.Write(StringIndex(note.fill_color));
+            writer.Write(note.y);
+            writer.Write(note.start_time);
+            writer.Write(note.end_time);
+            WriteVector3(writer, note.position);
+            WriteVector3(writer, note.rotation);
+            WriteVector3(writer, note.end_position);
+            writer.Write(note.holdlength);
+            writer.Write(note.initial_scale);
+            writer.Write(note.intro_time);
+            writer.Write(note.direction);
+            writer.Write(note.tint);
+            writer.Write(note.nextdraglinestarttime);
+            writer.Write(note.nextdraglinestoptime);
+            writer.Write(note.style);
+        }
+    }
+
+    private static ChartModel Read(BinaryReader reader)
+    {
+        var strings = new string[reader.ReadInt32()];
+        for (var i = 0; i < strings.Length; i++) strings[i] = reader.ReadString();
+
+        string ReadString()
+        {
+            var index = reader.ReadInt32();
+            return index < 0 ? null : strings[index];
+        }
+
+        var model = new ChartModel
+        {
+            time_base = reader.ReadDouble(),
+            music_offset = reader.ReadDouble(),
+            size = reader.ReadDouble(),
+            opacity = reader.ReadDouble(),
+            ring_color = ReadString()
+        };
+        var fillColorCount = reader.ReadInt32();
+        if (fillColorCount < 0)
+        {
+            model.fill_colors = null;
+        }
+        else
+        {
+            model.fill_colors = new string[fillColorCount];
+            for (var i = 0; i < fillColorCount; i++) model.fill_colors[i] = ReadString();
+        }
+        model.display_boundaries = ReadNullableBool(reader);
+        model.display_background = ReadNullableBool(reader);
+        model.horizontal_margin = ReadNullableInt(reader);
+        model.vertical_margin = ReadNullableInt(reader);
+        model.restrict_play_area_aspect_ratio = ReadNullableBool(reader);
+        model.skip_music_on_completion = ReadNullableBool(reader);
+
+        var tempoCount = reader.ReadInt32();
+        model.tempo_list = new List<ChartModel.Tempo>(tempoCount);
+        for (var i = 0; i < tempoCount; i++)
+        {
+            model.tempo_list.Add(new ChartModel.Tempo
+            {
+                tick = reader.ReadDouble(),
+                value = reader.ReadInt64()
+            });
+        }
+
+        var pageCount = reader.ReadInt32();
+        model.page_list = new List<ChartModel.Page>(pageCount);
+        for (var i = 0; i < pageCount; i++)
+        {
+            model.page_list.Add(new ChartModel.Page
+            {
+                start_tick = reader.ReadDouble(),
+                end_tick = reader.ReadDouble(),
+                scan_line_direction = reader.ReadInt32(),
+                start_time = reader.ReadSingle(),
+                end_time = reader.ReadSingle(),
+                actual_start_tick = reader.ReadSingle(),
+                actual_start_time = reader.ReadSingle()
+            });
+        }
+
+        var eventOrderCount = reader.ReadInt32();
+        model.event_order_list = new List<ChartModel.EventOrder>(eventOrderCount);
+        for (var i = 0; i < eventOrderCount; i++)
+        {
+            var eventOrder = new ChartModel.EventOrder
+            {
+                tick = reader.ReadInt32(),
+                time = reader.ReadSingle()
+            };
+            var eventCount = reader.ReadInt32();
+            if (eventCount >= 0)
+            {
+                eventOrder.event_list = new List<ChartModel.ChartEvent>(eventCount);
+                for (var j = 0; j < eventCount; j++)
+                {
+                    eventOrder.event_list.Add(new ChartModel.ChartEvent
+                    {
+                        type = reader.ReadInt32(),
+                        args = ReadString()
+                    });
+                }
+            }
+            model.event_order_list.Add(eventOrder);
+        }
+
+        var noteCount = reader.ReadInt32();
+        model.note_list = new List<ChartModel.Note>(noteCount);
+        for (var i = 0; i < noteCount; i++)
+        {
+            model.note_list.Add(new ChartModel.Note
+            {
+                page_index = reader.ReadInt32(),
+                type = reader.ReadInt32(),
+                id = reader.ReadInt32(),
+                tick = reader.ReadDouble(),
+                x = reader.ReadDouble(),
+                has_sibling = reader.ReadBoolean(),
+                hold_tick = reader.ReadDouble(),
+                next_id = reader.ReadInt32(),
+                is_forward = reader.ReadBoolean(),
+                approach_rate = reader.ReadDouble(),
+                size = reader.ReadDouble(),
+                opacity = reader.ReadDouble(),
+                hitbox = reader.ReadDouble(),
+                ring_color = ReadString(),
+                fill_color = ReadString(),
+                y = reader.ReadSingle(),
+                start_time = reader.ReadSingle(),
+                end_time = reader.ReadSingle(),
+                position = ReadVector3(reader),
+                rotation = ReadVector3(reader),
+                end_position = ReadVector3(reader),
+                holdlength = reader.ReadSingle(),
+                initial_scale = reader.ReadSingle(),
+                intro_time = reader.ReadSingle(),
+                direction = reader.ReadInt32(),
+                tint = reader.ReadSingle(),
+                nextdraglinestarttime = reader.ReadSingle(),
+                nextdraglinestoptime = reader.ReadSingle(),
+                style = reader.ReadInt32()
+            });
+        }
+
+        return model;
+    }
+
+    private static void WriteNullable(BinaryWriter writer, bool? value)
+    {
+        writer.Write((sbyte) (value == null ? -1 : value.Value ? 1 : 0));
+    }
+
+    private static void WriteNullable(BinaryWriter writer, int? value)
+    {
+        writer.Write(value != null);
+        writer.Write(value ?? 0);
+    }
+
+    private static bool? ReadNullableBool(BinaryReader reader)
+    {
+        var value = reader.ReadSByte();
+        if (value < 0) return null;
+        return value == 1;
+    }
+
+    private static int? ReadNullableInt(BinaryReader reader)
+    {
+        var hasValue = reader.ReadBoolean();
+        var value = reader.ReadInt32();
+        return hasValue ? value : (int?) null;
+    }
+
+    private static void WriteVector3(BinaryWriter writer, Vector3 value)
+    {
+        writer.Write(value.x);
+        writer.Write(value.y);
+        writer.Write(value.z);
+    }
+
+    private static Vector3 ReadVector3(BinaryReader reader)
+    {
+        return new Vector3(reader.ReadSingle(), reader.ReadSingle(), reader.ReadSingle());
+    }
+}
@@ -12,7 +12,7 @@ public class ChartModel
     public List<Tempo> tempo_list = new List<Tempo>();
     public List<Page> page_list = new List<Page>();
     public List<Note> note_list = new List<Note>();
-    public Dictionary<int, Note> note_map = new Dictionary<int, Note>();
+    public Note[] note_map = new Note[0]; // Indexed by note id
     public List<EventOrder> event_order_list = new List<EventOrder>();
 
     public double music_offset;
@@ -26,6 +26,8 @@ public class ChartModel
     public int? vertical_margin;
     public bool? restrict_play_area_aspect_ratio;
     public bool? skip_music_on_completion;
+
+    public bool HasNote(int id) => id >= 0 && id < note_map.Length && note_map[id] != null;
     
     [Serializable]
     public class Page
@@ -125,6 +127,37 @@ public class ChartModel
             return pos;
         }
 
+        /**
+         * Points the note from currentPosition towards nextPosition (if it has a next note), applies the rotation
+         * overrides and stores the result in rotation.
+         */
+        public Vector3 UpdateRotation(Vector3 currentPosition, Vector3? nextPosition)
+        {
+            if (nextPosition != null)
+            {
+                var next = nextPosition.Value;
+                if (currentPosition == next)
+                    rotation = Vector3.zero;
+                else if (Math.Abs(currentPosition.y - next.y) < 0.000001)
+                    rotation = new Vector3(0, 0, currentPosition.x > next.x ? 90 : -90);
+                else if (Math.Abs(currentPosition.x - next.x) < 0.000001)
+                    rotation = new Vector3(0, 0, currentPosition.y > next.y ? -180 : 0);
+                else
+                    rotation = new Vector3(0, 0, -(
+                        Mathf.Atan((next.x - currentPosition.x) /
+                                   (next.y - currentPosition.y)) / Mathf.PI * 180f +
+                        (next.y > currentPosition.y ? 0 : 180)));
+            }
+
+            var ovr = Override;
+            var result = rotation;
+            if (ovr.RotX != null) result.x = ovr.RotX.Value;
+            if (ovr.RotY != null) result.y = ovr.RotY.Value;
+            if (ovr.RotZ != null) result.z = ovr.RotZ.Value;
+
+            return rotation = result;
+        }
+
         public NoteOverride Override { get; } = new NoteOverride();
 
         public class NoteOverride
@@ -144,6 +177,7 @@ public class ChartModel
             public float OpacityMultiplier = 1;
             public float SizeMultiplier = 1;
             public float HitboxMultiplier = 1;
+            public int Version; // Incremented whenever the ring/fill color, size or hitbox override is written
         }
         
         public float Duration => end_time - start_time;
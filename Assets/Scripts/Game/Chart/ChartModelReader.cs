@@ -0,0 +1,388 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.Text;
+using Newtonsoft.Json;
+
+/**
+ * Forward-only chart parser that reads a ChartModel directly from a stream with a JsonTextReader, without building an
+ * intermediate string or object graph. Unknown properties are skipped; property names are matched case-insensitively
+ * like JsonConvert does.
+ */
+public static class ChartModelReader
+{
+    // Rough size of a serialized note, used to pre-size the note list from the file length
+    private const int EstimatedBytesPerNote = 120;
+
+    public static ChartModel ReadFile(string path)
+    {
+        using (var stream = new FileStream(path, FileMode.Open, FileAccess.Read, FileShare.Read, 64 * 1024))
+        {
+            try
+            {
+                return Read(stream, (int) Math.Min(stream.Length / EstimatedBytesPerNote, int.MaxValue));
+            }
+            catch (JsonReaderException)
+            {
+                // Legacy format
+                stream.Position = 0;
+                using (var streamReader = new StreamReader(stream, Encoding.UTF8))
+                {
+                    return Chart.FromLegacyChart(streamReader.ReadToEnd());
+                }
+            }
+        }
+    }
+
+    public static ChartModel Read(Stream stream, int noteCapacity = 0)
+    {
+        var streamReader = new StreamReader(stream, Encoding.UTF8, true, 64 * 1024);
+        using (var reader = new JsonTextReader(streamReader) {CloseInput = false})
+        {
+            if (!reader.Read() || reader.TokenType != JsonToken.StartObject)
+            {
+                throw new JsonReaderException("Expected chart object");
+            }
+
+            var model = new ChartModel();
+            model.note_list = new List<ChartModel.Note>(noteCapacity);
+            while (ReadProperty(reader, out var name))
+            {
+                switch (name)
+                {
+                    case "time_base":
+                        model.time_base = reader.ReadAsDouble() ?? model.time_base;
+                        break;
+                    case "tempo_list":
+                        ReadArray(reader, model.tempo_list, ReadTempo);
+                        break;
+                    case "page_list":
+                        ReadArray(reader, model.page_list, ReadPage);
+                        break;
+                    case "note_list":
+                        ReadArray(reader, model.note_list, ReadNote);
+                        break;
+                    case "event_order_list":
+                        ReadArray(reader, model.event_order_list, ReadEventOrder);
+                        break;
+                    case "music_offset":
+                        model.music_offset = reader.ReadAsDouble() ?? model.music_offset;
+                        break;
+                    case "size":
+                        model.size = reader.ReadAsDouble() ?? model.size;
+                        break;
+                    case "opacity":
+                        model.opacity = reader.ReadAsDouble() ?? model.opacity;
+                        break;
+                    case "ring_color":
+                        model.ring_color = reader.ReadAsString();
+                        break;
+                    case "fill_colors":
+                        var fillColors = new List<string>(12);
+                        if (ReadArray(reader, fillColors, ReadStringValue))
+                        {
+                            model.fill_colors = fillColors.ToArray();
+                        }
+                        break;
+                    case "display_boundaries":
+                        model.display_boundaries = reader.ReadAsBoolean();
+                        break;
+                    case "display_background":
+                        model.display_background = reader.ReadAsBoolean();
+                        break;
+                    case "horizontal_margin":
+                        model.horizontal_margin = reader.ReadAsInt32();
+                        break;
+                    case "vertical_margin":
+                        model.vertical_margin = reader.ReadAsInt32();
+                        break;
+                    case "restrict_play_area_aspect_ratio":
+                        model.restrict_play_area_aspect_ratio = reader.ReadAsBoolean();
+                        break;
+                    case "skip_music_on_completion":
+                        model.skip_music_on_completion = reader.ReadAsBoolean();
+                        break;
+                    default:
+                        SkipValue(reader);
+                        break;
+                }
+            }
+
+            return model;
+        }
+    }
+
+    private static ChartModel.Tempo ReadTempo(JsonTextReader reader)
+    {
+        var tempo = new ChartModel.Tempo();
+        ExpectObject(reader);
+        while (ReadProperty(reader, out var name))
+        {
+            switch (name)
+            {
+                case "tick":
+                    tempo.tick = reader.ReadAsDouble() ?? tempo.tick;
+                    break;
+                case "value":
+                    tempo.value = ReadInt64(reader) ?? tempo.value;
+                    break;
+                default:
+                    SkipValue(reader);
+                    break;
+            }
+        }
+
+        return tempo;
+    }
+
+    private static ChartModel.Page ReadPage(JsonTextReader reader)
+    {
+        var page = new ChartModel.Page();
+        ExpectObject(reader);
+        while (ReadProperty(reader, out var name))
+        {
+            switch (name)
+            {
+                case "start_tick":
+                    page.start_tick = reader.ReadAsDouble() ?? page.start_tick;
+                    break;
+                case "end_tick":
+                    page.end_tick = reader.ReadAsDouble() ?? page.end_tick;
+                    break;
+                case "scan_line_direction":
+                    page.scan_line_direction = reader.ReadAsInt32() ?? page.scan_line_direction;
+                    break;
+                default:
+                    SkipValue(reader);
+                    break;
+            }
+        }
+
+        return page;
+    }
+
+    private static ChartModel.EventOrder ReadEventOrder(JsonTextReader reader)
+    {
+        var eventOrder = new ChartModel.EventOrder();
+        ExpectObject(reader);
+        while (ReadProperty(reader, out var name))
+        {
+            switch (name)
+            {
+                case "tick":
+                    eventOrder.tick = reader.ReadAsInt32() ?? eventOrder.tick;
+                    break;
+                case "event_list":
+                    var events = new List<ChartModel.ChartEvent>(1);
+                    if (ReadArray(reader, events, ReadEvent))
+                    {
+                        eventOrder.event_list = events;
+                    }
+                    break;
+                default:
+                    SkipValue(reader);
+                    break;
+            }
+        }
+
+        return eventOrder;
+    }
+
+    private static ChartModel.ChartEvent ReadEvent(JsonTextReader reader)
+    {
+        var chartEvent = new ChartModel.ChartEvent();
+        ExpectObject(reader);
+        while (ReadProperty(reader, out var name))
+        {
+            switch (name)
+            {
+                case "type":
+                    chartEvent.type = reader.ReadAsInt32() ?? chartEvent.type;
+                    break;
+                case "args":
+                    chartEvent.args = reader.ReadAsString();
+                    break;
+                default:
+                    SkipValue(reader);
+                    break;
+            }
+        }
+
+        return chartEvent;
+    }
+
+    private static ChartModel.Note ReadNote(JsonTextReader reader)
+    {
+        var note = new ChartModel.Note();
+        ExpectObject(reader);
+        while (ReadProperty(reader, out var name))
+        {
+            switch (name)
+            {
+                case "page_index":
+                    note.page_index = reader.ReadAsInt32() ?? note.page_index;
+                    break;
+                case "type":
+                    note.type = reader.ReadAsInt32() ?? note.type;
+                    break;
+                case "id":
+                    note.id = reader.ReadAsInt32() ?? note.id;
+                    break;
+                case "tick":
+                    note.tick = reader.ReadAsDouble() ?? note.tick;
+                    break;
+                case "x":
+                    note.x = reader.ReadAsDouble() ?? note.x;
+                    break;
+                case "has_sibling":
+                    note.has_sibling = reader.ReadAsBoolean() ?? note.has_sibling;
+                    break;
+                case "hold_tick":
+                    note.hold_tick = reader.ReadAsDouble() ?? note.hold_tick;
+                    break;
+                case "next_id":
+                    note.next_id = reader.ReadAsInt32() ?? note.next_id;
+                    break;
+                case "is_forward":
+                    note.is_forward = reader.ReadAsBoolean() ?? note.is_forward;
+                    break;
+                case "approach_rate":
+                    note.approach_rate = reader.ReadAsDouble() ?? note.approach_rate;
+                    break;
+                case "size":
+                    note.size = reader.ReadAsDouble() ?? note.size;
+                    break;
+                case "opacity":
+                    note.opacity = reader.ReadAsDouble() ?? note.opacity;
+                    break;
+                case "hitbox":
+                    note.hitbox = reader.ReadAsDouble() ?? note.hitbox;
+                    break;
+                case "ring_color":
+                    note.ring_color = reader.ReadAsString();
+                    break;
+                case "fill_color":
+                    note.fill_color = reader.ReadAsString();
+                    break;
+                case "style":
+                    note.style = reader.ReadAsInt32() ?? note.style;
+                    break;
+                default:
+                    SkipValue(reader);
+                    break;
+            }
+        }
+
+        return note;
+    }
+
+    private static void ExpectObject(JsonTextReader reader)
+    {
+        if (reader.TokenType != JsonToken.StartObject)
+        {
+            throw new JsonReaderException($"Expected object at {reader.Path}, but got {reader.TokenType}");
+        }
+    }
+
+    /**
+     * Moves to the next property of the current object. Returns false once the end of the object is reached.
+     */
+    private static bool ReadProperty(JsonTextReader reader, out string name)
+    {
+        while (reader.Read())
+        {
+            switch (reader.TokenType)
+            {
+                case JsonToken.EndObject:
+                    name = null;
+                    return false;
+                case JsonToken.PropertyName:
+                    name = NormalizePropertyName((string) reader.Value);
+                    return true;
+                case JsonToken.Comment:
+                    break;
+                default:
+                    throw new JsonReaderException($"Unexpected token {reader.TokenType} at {reader.Path}");
+            }
+        }
+
+        throw new JsonReaderException("Unexpected end of chart");
+    }
+
+    private static void SkipValue(JsonTextReader reader)
+    {
+        reader.Read();
+        reader.Skip();
+    }
+
+    /**
+     * Moves to the next token, which should be an array or null, and reads each element into the list. The element
+     * reader is invoked with the reader positioned at the start of the element. Returns false if the value was null.
+     */
+    private static bool ReadArray<T>(JsonTextReader reader, List<T> list, Func<JsonTextReader, T> elementReader)
+    {
+        reader.Read();
+        if (reader.TokenType == JsonToken.Null) return false;
+        if (reader.TokenType != JsonToken.StartArray)
+        {
+            throw new JsonReaderException($"Expected array at {reader.Path}, but got {reader.TokenType}");
+        }
+
+        while (reader.Read())
+        {
+            switch (reader.TokenType)
+            {
+                case JsonToken.EndArray:
+                    return true;
+                case JsonToken.Comment:
+                    break;
+                default:
+                    list.Add(elementReader(reader));
+                    break;
+            }
+        }
+
+        throw new JsonReaderException("Unexpected end of chart");
+    }
+
+    private static string ReadStringValue(JsonTextReader reader)
+    {
+        switch (reader.TokenType)
+        {
+            case JsonToken.Null:
+                return null;
+            case JsonToken.String:
+                return (string) reader.Value;
+            default:
+                return Convert.ToString(reader.Value, CultureInfo.InvariantCulture);
+        }
+    }
+
+    private static long? ReadInt64(JsonTextReader reader)
+    {
+        reader.Read();
+        switch (reader.TokenType)
+        {
+            case JsonToken.Null:
+                return null;
+            case JsonToken.Integer:
+            case JsonToken.Float:
+                return Convert.ToInt64(reader.Value, CultureInfo.InvariantCulture);
+            case JsonToken.String:
+                return long.Parse((string) reader.Value, CultureInfo.InvariantCulture);
+            default:
+                throw new JsonReaderException($"Expected integer at {reader.Path}, but got {reader.TokenType}");
+        }
+    }
+
+    private static string NormalizePropertyName(string name)
+    {
+        foreach (var c in name)
+        {
+            if (char.IsUpper(c)) return name.ToLowerInvariant();
+        }
+
+        return name;
+    }
+}
@@ -0,0 +1,43 @@
+using System.Collections.Generic;
+
+/**
+ * Computes the peak number of simultaneously open [start, end] intervals with a sweep line. Intervals that touch at an
+ * end point are counted as overlapping.
+ */
+public class IntervalSweep
+{
+    private readonly List<float> starts;
+    private readonly List<float> ends;
+
+    public IntervalSweep(int capacity = 0)
+    {
+        starts = new List<float>(capacity);
+        ends = new List<float>(capacity);
+    }
+
+    public void Add(float start, float end)
+    {
+        starts.Add(start);
+        ends.Add(end < start ? start : end);
+    }
+
+    public int GetPeak()
+    {
+        starts.Sort();
+        ends.Sort();
+        int count = 0, peak = 0, endIndex = 0;
+        foreach (var start in starts)
+        {
+            while (ends[endIndex] < start)
+            {
+                count--;
+                endIndex++;
+            }
+
+            count++;
+            if (count > peak) peak = count;
+        }
+
+        return peak;
+    }
+}
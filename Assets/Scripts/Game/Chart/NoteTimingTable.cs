@@ -0,0 +1,44 @@
+/**
+ * Structure-of-arrays view of the derived note fields that the per-frame gameplay code reads (spawn loop, emerge and
+ * miss checks, collider windows), indexed by note id like ChartModel.note_map, which has a note for every id (see
+ * Chart.IndexNotes). Scanning these arrays avoids pulling whole ChartModel.Note objects into cache. Built once after
+ * the chart is derived; note times never change afterwards.
+ */
+public class NoteTimingTable
+{
+    public readonly int Count;
+
+    public readonly float[] StartTimes;
+    public readonly float[] EndTimes;
+    public readonly float[] IntroTimes;
+    public readonly float[] X; // Screen space
+    public readonly float[] Y; // Screen space
+    public readonly NoteType[] Types;
+    public readonly int[] PageIndices;
+    public readonly int[] NextIds;
+
+    public NoteTimingTable(ChartModel.Note[] noteMap)
+    {
+        Count = noteMap.Length;
+        StartTimes = new float[Count];
+        EndTimes = new float[Count];
+        IntroTimes = new float[Count];
+        X = new float[Count];
+        Y = new float[Count];
+        Types = new NoteType[Count];
+        PageIndices = new int[Count];
+        NextIds = new int[Count];
+        for (var id = 0; id < Count; id++)
+        {
+            var note = noteMap[id];
+            StartTimes[id] = note.start_time;
+            EndTimes[id] = note.end_time;
+            IntroTimes[id] = note.intro_time;
+            X[id] = note.position.x;
+            Y[id] = note.position.y;
+            Types[id] = (NoteType) note.type;
+            PageIndices[id] = note.page_index;
+            NextIds[id] = note.next_id;
+        }
+    }
+}
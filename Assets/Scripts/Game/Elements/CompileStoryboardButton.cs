@@ -1,6 +1,4 @@
-using System;
 using System.IO;
-using Newtonsoft.Json;
 
 public class CompileStoryboardButton : InteractableMonoBehavior
 {
@@ -10,12 +8,11 @@ public class CompileStoryboardButton : InteractableMonoBehavior
     {
         onPointerClick.AddListener(_ =>
         {
-            var jObject = game.Storyboard.Compile();
-            var path = game.Level.Path + "/storyboard_compiled.json";
-            File.WriteAllText(path, JsonConvert.SerializeObject(jObject, Formatting.None, new JsonSerializerSettings
+            var path = game.Level.Path + "/storyboard_compiled.bin";
+            using (var stream = File.Create(path))
             {
-                NullValueHandling = NullValueHandling.Ignore
-            }));
+                game.Storyboard.Compile(stream);
+            }
         });
     }
 }
\ No newline at end of file
@@ -47,8 +47,7 @@ public class NoteOffsetWidget : MonoBehaviour
         autoplayRadioGroup.onSelect.AddListener(it =>
         {
             var value = bool.Parse(it);
-            if (value) game.State.Mods.Add(Mod.Auto);
-            else game.State.Mods.Remove(Mod.Auto);
+            game.State.SetMod(Mod.Auto, value);
         });
         decreaseMoreButton.onPointerClick.AddListener(it => ChangeGameNoteOffset(-0.05f));
         decreaseButton.onPointerClick.AddListener(it => ChangeGameNoteOffset(-0.01f));
@@ -73,7 +72,7 @@ public class NoteOffsetWidget : MonoBehaviour
                 game.onGameAborted.AddListener(_ => transitionElement.Leave());
                 game.onGameRetried.AddListener(_ => transitionElement.Leave());
                 autoplayRadioGroup.Select("true", false);
-                game.State.Mods.Add(Mod.Auto);
+                game.State.SetMod(Mod.Auto, true);
                 transform.RebuildLayout();
             }
         });
@@ -7,6 +7,7 @@ using System.Threading;
 using UnityEngine;
 using Cysharp.Threading.Tasks;
 using Cytoid.Storyboard;
+using Newtonsoft.Json.Linq;
 using LiteDB;
 using Polyglot;
 using Sentry;
@@ -39,6 +40,7 @@ public class Game : MonoBehaviour
     public string StoryboardPath { get; protected set; }
 
     public float Time { get; protected set; }
+    public double TimeSampledAt { get; protected set; } // Unscaled realtime at which Time was last updated
     public float MusicLength { get; protected set; }
     public float ChartLength { get; protected set; }
     public float GameStartedOrResumedTimestamp { get; protected set; }
@@ -53,6 +55,8 @@ public class Game : MonoBehaviour
 
     public ObjectPool ObjectPool { get; set; }
 
+    public NoteUpdateScheduler NoteUpdateScheduler { get; } = new NoteUpdateScheduler();
+
     public SortedDictionary<int, Note> SpawnedNotes => ObjectPool.SpawnedNotes;
 
     public string EditorDefaultLevelDirectory = "yy.badapple";
@@ -62,6 +66,7 @@ public class Game : MonoBehaviour
     public bool EditorImmediatelyComplete;
     public float EditorCompletionDelay;
     public bool EditorImmediatelyCompleteFail;
+    public string EditorReplayPath;
 
     public AudioManager.Controller Music { get; protected set; }
 
@@ -91,6 +96,8 @@ public class Game : MonoBehaviour
 
     private GlobalCalibrator globalCalibrator;
 
+    private readonly List<Chart.DragLineSegment> dragLineSegmentsToSpawn = new List<Chart.DragLineSegment>();
+
     protected virtual void Awake()
     {
         ContentLayer = LayerMask.NameToLayer("Content");
@@ -101,6 +108,7 @@ public class Game : MonoBehaviour
         EditorForceAutoMod = false;
         EditorImmediatelyComplete = false;
         EditorImmediatelyCompleteFail = false;
+        EditorReplayPath = null;
 #endif
     }
 
@@ -213,21 +221,15 @@ public class Game : MonoBehaviour
             },
             level: BreadcrumbLevel.Info);
 
-        // Load chart
-        print("Loading chart");
+        // Load chart, audio and storyboard concurrently: chart preparation and storyboard JSON parsing run on the
+        // thread pool with the Unity state they need captured up front, while audio is loaded on the main thread
+        print("Loading chart, audio and storyboard");
+        var loadTimer = new BenchmarkTimer("Game loading");
         var chartMeta = Level.Meta.GetChartSection(Difficulty.Id);
-        var chartPath = "file://" + Level.Path + chartMeta.path;
-        string chartText;
-        using (var request = UnityWebRequest.Get(chartPath))
+        var chartPath = Level.Path + chartMeta.path;
+        if (!File.Exists(chartPath))
         {
-            await request.SendWebRequest();
-            if (request.isNetworkError || request.isHttpError)
-            {
-                Debug.LogError(request.error);
-                throw new Exception($"Failed to download chart from {chartPath}");
-            }
-
-            chartText = Encoding.UTF8.GetString(request.downloadHandler.data);
+            throw new Exception($"Failed to load chart from {chartPath}");
         }
 
         var mods = new HashSet<Mod>(Context.SelectedMods);
@@ -240,40 +242,36 @@ public class Game : MonoBehaviour
             mods.Clear();   
         }
 
-        Chart = new Chart(
-            chartText,
-            mods.Contains(Mod.FlipX) || mods.Contains(Mod.FlipAll),
-            mods.Contains(Mod.FlipY) || mods.Contains(Mod.FlipAll),
-            true,
-            Context.Player.Settings.UseExperimentalNoteAr,
-            mods.Contains(Mod.Fast) ? 1.5f : (mods.Contains(Mod.Slow) ? 0.75f : 1),
-            camera.orthographicSize
-        );
-        ChartLength = Chart.Model.note_list.Max(it => it.end_time);
-        foreach (var type in (NoteType[]) Enum.GetValues(typeof(NoteType)))
+        // Input replay
+        var replay = Context.SelectedReplay;
+        Context.SelectedReplay = null;
+        if (replay == null && Application.isEditor && !string.IsNullOrEmpty(EditorReplayPath))
         {
-            ObjectPool.UpdateNoteObjectCount(type, Chart.MaxSamePageNoteCountByType[type] * 3);
+            replay = InputReplay.Load(EditorReplayPath);
         }
-
-        // Load audio
-        print("Loading audio");
-        AudioListener.pause = false;
-
-        if (Context.AudioManager == null) await UniTask.WaitUntil(() => Context.AudioManager != null);
-        Context.AudioManager.Initialize();
-        var audioPath = "file://" + Level.Path + Level.Meta.GetMusicPath(Difficulty.Id);
-        var loader = new AudioClipLoader(audioPath);
-        await loader.Load();
-        if (loader.Error != null)
+        if (replay != null)
         {
-            Debug.LogError(loader.Error);
-            throw new Exception($"Failed to download audio from {audioPath}");
+            mods = new HashSet<Mod>(replay.Mods);
         }
 
-        Music = Context.AudioManager.Load("Level", loader.AudioClip, false, false, true);
-        MusicLength = Music.Length;
+        var isHorizontallyInverted = mods.Contains(Mod.FlipX) || mods.Contains(Mod.FlipAll);
+        var isVerticallyInverted = mods.Contains(Mod.FlipY) || mods.Contains(Mod.FlipAll);
+        var approachRateMultiplier = mods.Contains(Mod.Fast) ? 1.5f : (mods.Contains(Mod.Slow) ? 0.75f : 1);
+        var useExperimentalNoteAr = Context.Player.Settings.UseExperimentalNoteAr;
+        var cameraOrthographicSize = camera.orthographicSize;
+        var screenWidth = UnityEngine.Screen.width;
+        var screenHeight = UnityEngine.Screen.height;
+        var chartTask = UniTask.RunOnThreadPool(() => LoadChart(
+            chartPath,
+            isHorizontallyInverted,
+            isVerticallyInverted,
+            useExperimentalNoteAr,
+            approachRateMultiplier,
+            cameraOrthographicSize,
+            screenWidth,
+            screenHeight
+        ));
 
-        // Load storyboard
         string sbFile = null;
         if (chartMeta.storyboard != null)
         {
@@ -305,16 +303,54 @@ public class Game : MonoBehaviour
         //         SentryLevel.Error);
         // }
 
-        if (File.Exists(StoryboardPath))
+        var storyboardPath = StoryboardPath;
+        var storyboardTask = File.Exists(storyboardPath)
+            ? UniTask.RunOnThreadPool(() => ReadStoryboard(storyboardPath))
+            : UniTask.FromResult<(JObject, CompiledStoryboard)>(default);
+
+        async UniTask LoadMusic()
+        {
+            var audioTimer = new BenchmarkTimer("Audio");
+            AudioListener.pause = false;
+
+            if (Context.AudioManager == null) await UniTask.WaitUntil(() => Context.AudioManager != null);
+            Context.AudioManager.Initialize();
+            var audioPath = "file://" + Level.Path + Level.Meta.GetMusicPath(Difficulty.Id);
+            var loader = new AudioClipLoader(audioPath);
+            await loader.Load();
+            if (loader.Error != null)
+            {
+                Debug.LogError(loader.Error);
+                throw new Exception($"Failed to download audio from {audioPath}");
+            }
+
+            Music = Context.AudioManager.Load("Level", loader.AudioClip, false, false, true);
+            MusicLength = Music.Length;
+            audioTimer.Time();
+        }
+        var musicTask = LoadMusic();
+
+        var (chart, (storyboardRootObject, compiledStoryboard)) = await UniTask.WhenAll(chartTask, storyboardTask);
+        loadTimer.Time("Chart and storyboard JSON");
+        Chart = chart;
+        ChartLength = Chart.Model.note_list.Max(it => it.end_time);
+        foreach (var type in (NoteType[]) Enum.GetValues(typeof(NoteType)))
+        {
+            ObjectPool.UpdateNoteObjectCount(type, ObjectPool.WithSafetyMargin(Chart.MaxConcurrentNoteCountByType[type]));
+        }
+
+        await musicTask;
+        loadTimer.Time("Audio");
+
+        if (storyboardRootObject != null || compiledStoryboard != null)
         {
             // Initialize storyboard
-            // TODO: Why File.ReadAllText() works but not UnityWebRequest?
-            // (UnityWebRequest downloaded text could not be parsed by Newtonsoft.Json)
             try
             {
-                var storyboardText = File.ReadAllText(StoryboardPath);
-                Storyboard = new Cytoid.Storyboard.Storyboard(this, storyboardText);
-                Storyboard.Parse();
+                Storyboard = compiledStoryboard != null
+                    ? new Cytoid.Storyboard.Storyboard(this, compiledStoryboard)
+                    : new Cytoid.Storyboard.Storyboard(this, storyboardRootObject);
+                await UniTask.RunOnThreadPool(Storyboard.Parse); // Only renderer initialization needs the main thread
                 await Storyboard.Initialize();
                 print($"Loaded storyboard from {StoryboardPath}");
             }
@@ -323,6 +359,7 @@ public class Game : MonoBehaviour
                 Debug.LogError(e);
                 Debug.LogError("Could not load storyboard.");
             }
+            loadTimer.Time("Storyboard");
         }
 
         // Load hit sound
@@ -333,7 +370,7 @@ public class Game : MonoBehaviour
         }
 
         // State & config
-        State = new GameState(this, mode, mods);
+        State = new GameState(this, mode, mods) {IsPlayback = replay != null};
         Context.GameState = State;
 
         if (Application.isEditor) Debug.Log("Chart checksum: " + State.ChartChecksum);
@@ -341,7 +378,15 @@ public class Game : MonoBehaviour
         Config = new GameConfig(this);
 
         // Touch handlers
-        if (mode != GameMode.GlobalCalibration && !State.Mods.Contains(Mod.Auto))
+        if (replay != null)
+        {
+            if (replay.ChartChecksum != State.ChartChecksum)
+            {
+                throw new Exception("Input replay was recorded on a different chart");
+            }
+            inputController.StartPlayback(replay);
+        }
+        else if (mode != GameMode.GlobalCalibration && !State.Mods.Contains(Mod.Auto))
         {
             inputController.EnableInput();
         }
@@ -351,11 +396,16 @@ public class Game : MonoBehaviour
         Context.SetAutoRotation(false);
 
         // Update last played time
-        Level.Record.LastPlayedDate = DateTimeOffset.UtcNow;
-        Level.SaveRecord();
+        if (!State.IsPlayback)
+        {
+            Level.Record.LastPlayedDate = DateTimeOffset.UtcNow;
+            Level.SaveRecord();
+        }
 
         // Initialize note pool
         ObjectPool.Initialize();
+        loadTimer.Time("Pool");
+        loadTimer.Time();
 
         IsLoaded = true;
         if (mode != GameMode.GlobalCalibration)
@@ -373,6 +423,95 @@ public class Game : MonoBehaviour
         }
     }
 
+    private static Chart LoadChart(
+        string chartPath,
+        bool isHorizontallyInverted,
+        bool isVerticallyInverted,
+        bool useExperimentalNoteAr,
+        float approachRateMultiplier,
+        float cameraOrthographicSize,
+        int screenWidth,
+        int screenHeight)
+    {
+        var timer = new BenchmarkTimer("Chart");
+        var screenAspectRatio = 1.0f * screenWidth / screenHeight;
+        var cachePath = ChartCache.GetCachePath(chartPath);
+        var cacheKey = ChartCache.CreateKey(
+            chartPath,
+            isHorizontallyInverted,
+            isVerticallyInverted,
+            useExperimentalNoteAr,
+            approachRateMultiplier,
+            cameraOrthographicSize,
+            screenWidth,
+            screenHeight
+        );
+        timer.Time("Hash");
+        var cachedModel = ChartCache.TryLoad(cachePath, cacheKey);
+        timer.Time("Cache lookup");
+        if (cachedModel != null)
+        {
+            print("Loaded chart from cache");
+            var cachedChart = new Chart(
+                cachedModel,
+                isHorizontallyInverted,
+                isVerticallyInverted,
+                true,
+                cameraOrthographicSize,
+                screenAspectRatio
+            );
+            timer.Time();
+            return cachedChart;
+        }
+
+        var model = ChartModelReader.ReadFile(chartPath);
+        timer.Time("Parse");
+        var chart = new Chart(
+            model,
+            isHorizontallyInverted,
+            isVerticallyInverted,
+            true,
+            useExperimentalNoteAr,
+            approachRateMultiplier,
+            cameraOrthographicSize,
+            screenAspectRatio
+        );
+        timer.Time("Derive");
+        ChartCache.Save(cachePath, cacheKey, chart.Model);
+        timer.Time();
+        return chart;
+    }
+
+    /**
+     * Returns either the parsed JSON root object or, for binary compiled storyboards, the loaded objects.
+     */
+    private static (JObject, CompiledStoryboard) ReadStoryboard(string path)
+    {
+        // TODO: Why File.ReadAllText() works but not UnityWebRequest?
+        // (UnityWebRequest downloaded text could not be parsed by Newtonsoft.Json)
+        try
+        {
+            if (CompiledStoryboard.IsCompiled(path))
+            {
+                var compiledTimer = new BenchmarkTimer("Compiled storyboard");
+                var compiledStoryboard = CompiledStoryboard.Load(path);
+                compiledTimer.Time();
+                return (null, compiledStoryboard);
+            }
+
+            var timer = new BenchmarkTimer("Storyboard JSON");
+            var rootObject = JObject.Parse(File.ReadAllText(path));
+            timer.Time();
+            return (rootObject, null);
+        }
+        catch (Exception e)
+        {
+            Debug.LogError(e);
+            Debug.LogError("Could not load storyboard.");
+            return default;
+        }
+    }
+
     protected virtual async void StartGame()
     {
         await UniTask.WhenAll(BeforeStartTasks);
@@ -440,6 +579,14 @@ public class Game : MonoBehaviour
         }
     }
 
+    /**
+     * Maps an unscaled realtime (UnityEngine.Time.unscaledTimeAsDouble) onto the chart time.
+     */
+    public float GetTimeAt(double realtime)
+    {
+        return Time + (float) (realtime - TimeSampledAt);
+    }
+
     protected virtual void Update()
     {
         if (!IsLoaded) return;
@@ -464,6 +611,7 @@ public class Game : MonoBehaviour
             if (!State.IsCompleted || !Music.IsFinished())
             {
                 SynchronizeMusic();
+                TimeSampledAt = UnityEngine.Time.unscaledTimeAsDouble;
             }
 
             MusicProgress = Time / MusicLength;
@@ -503,31 +651,29 @@ public class Game : MonoBehaviour
                 }
 
                 var notes = Chart.Model.note_map;
-                while (Chart.CurrentNoteId < notes.Count && notes[Chart.CurrentNoteId].intro_time - 1f < Time)
-                    switch ((NoteType) notes[Chart.CurrentNoteId].type)
-                    {
-                        case NoteType.DragHead:
-                        case NoteType.CDragHead:
-                            var id = Chart.CurrentNoteId;
-                            while (notes[id].next_id > 0)
-                            {
-                                ObjectPool.SpawnDragLine(notes[id], notes[notes[id].next_id]);
-                                id = notes[id].next_id;
-                            }
-
-                            ObjectPool.SpawnNote(notes[Chart.CurrentNoteId]);
-                            Chart.CurrentNoteId++;
-                            break;
-                        default:
-                            ObjectPool.SpawnNote(notes[Chart.CurrentNoteId]);
-                            Chart.CurrentNoteId++;
-                            break;
-                    }
+                var timings = Chart.NoteTimings;
+                // Note ids are contiguous (see Chart.IndexNotes), so every id up to timings.Count has a note to spawn
+                while (Chart.CurrentNoteId < timings.Count && timings.IntroTimes[Chart.CurrentNoteId] - 1f < Time)
+                {
+                    ObjectPool.SpawnNote(notes[Chart.CurrentNoteId]);
+                    Chart.CurrentNoteId++;
+                }
+
+                // Drag lines are spawned link by link shortly before they start to be drawn
+                dragLineSegmentsToSpawn.Clear();
+                Chart.CollectDragLineSegmentsToSpawn(Time, dragLineSegmentsToSpawn);
+                foreach (var segment in dragLineSegmentsToSpawn)
+                {
+                    ObjectPool.SpawnDragLine(notes[segment.FromId], notes[segment.ToId]);
+                }
             }
         }
 
         onGameUpdate.Invoke(this);
+        NoteUpdateScheduler.Update();
         onGameLateUpdate.Invoke(this);
+        NoteUpdateScheduler.LateUpdate();
+        inputController.UpdateGrids();
     }
 
     protected virtual void OnApplicationPause(bool willPause)
@@ -762,6 +908,7 @@ public class Game : MonoBehaviour
     {
         onGameUpdate.RemoveAllListeners();
         onGameLateUpdate.RemoveAllListeners();
+        NoteUpdateScheduler.Clear();
 
         inputController.DisableInput();
         ObjectPool.Dispose();
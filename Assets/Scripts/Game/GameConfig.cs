@@ -12,6 +12,7 @@ public class GameConfig
     // TODO: Optimize color override; don't compare it with Color.clear!
     public Color GlobalRingColorOverride;
     public readonly Dictionary<NoteType, Color[]> GlobalFillColorsOverride = new Dictionary<NoteType, Color[]>();
+    public int OverrideVersion; // Incremented whenever the global color overrides are written
 
     public bool UseClassicStyle = true;
     public bool DisplayNoteIds;
@@ -50,6 +51,7 @@ public class GameConfig
         DisplayNoteIds = Context.Player.Settings.DisplayNoteIds;
 
         GlobalRingColorOverride = chart.Model.ring_color?.ToColor() ?? Color.clear;
+        OverrideVersion++;
         foreach (NoteType type in Enum.GetValues(typeof(NoteType)))
         {
             GlobalFillColorsOverride[type] = new[]
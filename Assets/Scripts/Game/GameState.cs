@@ -1,6 +1,5 @@
 using System;
 using System.Collections.Generic;
-using System.Linq;
 using UnityEngine;
 
 public sealed class GameState
@@ -23,11 +22,14 @@ public sealed class GameState
     public bool IsReadyToExit { get; set; }
 
     public bool IsFailed { get; set; }
+
+    // Whether the judgements come from an input replay; such games save no records and show no results
+    public bool IsPlayback { get; set; }
     public HashSet<Mod> Mods { get; }
     public SecuredDouble MaxHealth { get; } = new SecuredDouble();
     public int NoteCount { get; }
 
-    public Dictionary<int, NoteJudgement> Judgements { get; private set; } = new Dictionary<int, NoteJudgement>();
+    public NoteJudgement[] Judgements { get; private set; } = new NoteJudgement[0]; // Indexed by note id
 
     public int ClearCount { get; private set; }
     public bool ShouldFail { get; private set; }
@@ -44,37 +46,40 @@ public sealed class GameState
 
     public double NoteScoreMultiplier { get; private set; } = 1.0;
 
+    // Cached Mods.Contains results; kept in sync by SetMod
+    public bool HasAutoMod { get; private set; }
+    private bool hasAllPerfectMod;
+    private bool hasFullComboMod;
+
     [AvailableOnComplete] public Dictionary<NoteGrade, int> GradeCounts => OnCompleteGuard(gradeCounts);
 
-    [AvailableOnComplete]
-    public int EarlyCount => OnCompleteGuard(
-        Judgements.Values.Count(it => it.Grade != NoteGrade.Perfect && it.Grade != NoteGrade.Miss && it.Error < 0)
-    );
+    [AvailableOnComplete] public int EarlyCount => OnCompleteGuard(earlyCount);
 
-    [AvailableOnComplete]
-    public int LateCount => OnCompleteGuard(
-        Judgements.Values.Count(it => it.Grade != NoteGrade.Perfect && it.Grade != NoteGrade.Miss && it.Error > 0)
-    );
+    [AvailableOnComplete] public int LateCount => OnCompleteGuard(lateCount);
 
+    /**
+     * Timing errors of all notes. Notes that were never judged count as an error of 0.
+     */
     [AvailableOnComplete]
-    public double AverageTimingError => OnCompleteGuard(
-        Judgements.Values.Sum(it => it.Error) / Judgements.Count
-    );
+    public RunningStatistics TimingErrors => OnCompleteGuard(RunningStatistics.Combine(
+        judgedTimingErrors,
+        new RunningStatistics {Count = Math.Max(0, NoteCount - judgedTimingErrors.Count)}
+    ));
 
-    [AvailableOnComplete]
-    public double StandardTimingError
-    {
-        get
-        {
-            OnCompleteGuard();
-            var difference = 0.0;
-            Judgements.Values.ForEach(it => difference += Math.Pow(AverageTimingError - it.Error, 2));
-            return Math.Sqrt(difference / Judgements.Count);
-        }
-    }
+    [AvailableOnComplete] public double AverageTimingError => TimingErrors.Mean;
+
+    [AvailableOnComplete] public double StandardTimingError => Math.Sqrt(TimingErrors.Variance);
 
     private bool isFullScorePossible = true;
     private readonly Dictionary<NoteGrade, int> gradeCounts = new Dictionary<NoteGrade, int>();
+    
+    // Running aggregates, updated in Judge
+    private readonly int[] judgedGradeCounts = new int[(int) NoteGrade.Perfect + 1]; // Indexed by grade
+    private int earlyCount;
+    private int lateCount;
+    private RunningStatistics judgedTimingErrors;
+
+    private HealthChange[] healthChanges; // See BuildHealthChangeTable
     private readonly double noteScoreMultiplierFactor;
     private double accumulatedAccuracy;
 
@@ -99,7 +104,7 @@ public sealed class GameState
         ChartChecksum = SecuredOperations.CalculateChartChecksum(Level, Difficulty);
 
         NoteCount = game.Chart.Model.note_list.Count;
-        game.Chart.Model.note_list.ForEach(it => Judgements[it.id] = new NoteJudgement());
+        Judgements = new NoteJudgement[game.Chart.Model.note_map.Length];
         noteScoreMultiplierFactor = Math.Sqrt(NoteCount) / 3.0;
 
         UseHealthSystem = Mods.Contains(Mod.Hard) || Mods.Contains(Mod.ExHard) || mode == GameMode.Tier;
@@ -126,6 +131,32 @@ public sealed class GameState
                 if (Application.isEditor && game.EditorForceAutoMod) Mods.Add(Mod.Auto);
                 break;
         }
+
+        UpdateModFlags();
+        BuildHealthChangeTable();
+    }
+
+    /**
+     * Creates a state for a chart that is played without a scene, e.g. by HeadlessGameSimulator. Tier mode uses the
+     * tier health mods, but does not touch Context.TierState.
+     */
+    public GameState(Chart chart, GameMode mode, HashSet<Mod> mods, int difficultyLevel, double? maxHealth = null)
+    {
+        DifficultyLevel = difficultyLevel;
+        Mode = mode;
+        Mods = new HashSet<Mod>(mods);
+
+        NoteCount = chart.Model.note_list.Count;
+        Judgements = new NoteJudgement[chart.Model.note_map.Length];
+        noteScoreMultiplierFactor = Math.Sqrt(NoteCount) / 3.0;
+
+        UseHealthSystem = Mods.Contains(Mod.Hard) || Mods.Contains(Mod.ExHard) || mode == GameMode.Tier;
+        MaxHealth = maxHealth ?? DifficultyLevel * 75;
+        if (MaxHealth <= 0) MaxHealth = 1000;
+        Health = MaxHealth;
+
+        UpdateModFlags();
+        BuildHealthChangeTable();
     }
 
     public GameState()
@@ -161,6 +192,7 @@ public sealed class GameState
         if (!Application.isEditor) throw new Exception();
 
         ClearCount = noteCount;
+        if (Judgements.Length < noteCount) Judgements = new NoteJudgement[noteCount];
         for (var i = 0; i < noteCount; i++)
             Judgements[i] = new NoteJudgement
             {
@@ -168,6 +200,10 @@ public sealed class GameState
                 Grade = NoteGrade.Perfect,
                 Error = 0,
             };
+        Array.Clear(judgedGradeCounts, 0, judgedGradeCounts.Length);
+        judgedGradeCounts[(int) NoteGrade.Perfect] = noteCount;
+        earlyCount = lateCount = 0;
+        judgedTimingErrors = new RunningStatistics {Count = noteCount};
         Combo = MaxCombo = noteCount;
 #if UNITY_EDITOR
         Score = 500000;
@@ -179,25 +215,38 @@ public sealed class GameState
     }
 
     public void Judge(Note note, NoteGrade grade, double error, double greatGradeWeight)
+    {
+        Judge(note.Model.id, note.Type, grade, error, greatGradeWeight);
+    }
+
+    public void Judge(int noteId, NoteType noteType, NoteGrade grade, double error, double greatGradeWeight)
     {
         if (IsCompleted || IsFailed)
         {
             return;
         }
 
-        if (Judgements[note.Model.id].IsJudged)
+        if (Judgements[noteId].IsJudged)
         {
             return;
-            Debug.LogWarning($"Trying to judge note {note.Model.id} which is already judged.");
+            Debug.LogWarning($"Trying to judge note {noteId} which is already judged.");
         }
 
         ClearCount++;
-        Judgements[note.Model.id].Apply(it =>
+        Judgements[noteId] = new NoteJudgement
         {
-            it.IsJudged = true;
-            it.Grade = grade;
-            it.Error = error;
-        });
+            IsJudged = true,
+            Grade = grade,
+            Error = error
+        };
+
+        judgedGradeCounts[(int) grade]++;
+        if (grade != NoteGrade.Perfect && grade != NoteGrade.Miss)
+        {
+            if (error < 0) earlyCount++;
+            else if (error > 0) lateCount++;
+        }
+        judgedTimingErrors.Add(error);
 
         if (Mode == GameMode.Practice)
         {
@@ -215,7 +264,7 @@ public sealed class GameState
         else Combo++;
         if (Combo > MaxCombo) MaxCombo = Combo;
 
-        if (Mode == GameMode.Tier)
+        if (Mode == GameMode.Tier && Context.TierState != null)
         {
             if (miss) Context.TierState.Combo = 0;
             else Context.TierState.Combo++;
@@ -305,27 +354,8 @@ public sealed class GameState
         // Health mods
         if (UseHealthSystem)
         {
-            var mods = Mods.Contains(Mod.ExHard) ? exHardHpMods : hardHpMods;
-            if (Mode == GameMode.Tier) mods = tierHpMods;
-
-            var mod = mods
-                .Select[note.Type]
-                .Select[Mode == GameMode.Practice ? unrankedGradingIndex[grade] : rankedGradingIndex[grade]];
-
-            double change = 0;
-
-            switch (mod.Type)
-            {
-                case HpModType.Absolute:
-                    change = mod.Value;
-                    break;
-                case HpModType.Percentage:
-                    change = mod.Value / 100f * MaxHealth;
-                    break;
-                case HpModType.DivideByNoteCount:
-                    change = mod.Value / NoteCount / 100f * MaxHealth;
-                    break;
-            }
+            var mod = healthChanges[GetHealthChangeIndex(noteType, grade)];
+            var change = mod.Value;
 
             if (change < 0 && mod.UseHealthBuffer)
             {
@@ -339,33 +369,53 @@ public sealed class GameState
             Health = Math.Min(Math.Max(Health, 0), MaxHealth);
             if (Health <= 0) ShouldFail = true;
 
-            if (Mode == GameMode.Tier)
+            if (Mode == GameMode.Tier && Context.TierState != null)
             {
                 Context.TierState.Health = Health;
             }
         }
 
         if (
-            Mods.Contains(Mod.AP) && grade != NoteGrade.Perfect
+            hasAllPerfectMod && grade != NoteGrade.Perfect
             ||
-            Mods.Contains(Mod.FC) && (grade == NoteGrade.Bad || grade == NoteGrade.Miss)
+            hasFullComboMod && (grade == NoteGrade.Bad || grade == NoteGrade.Miss)
         )
         {
             ShouldFail = true;
         }
     }
 
+    /**
+     * Adds or removes a mod during play. Use this instead of modifying Mods directly, so that the cached flags and the
+     * health change table stay in sync.
+     */
+    public void SetMod(Mod mod, bool enabled)
+    {
+        if (enabled) Mods.Add(mod);
+        else Mods.Remove(mod);
+        UpdateModFlags();
+        if (mod == Mod.Hard || mod == Mod.ExHard) BuildHealthChangeTable();
+    }
+
+    private void UpdateModFlags()
+    {
+        HasAutoMod = Mods.Contains(Mod.Auto);
+        hasAllPerfectMod = Mods.Contains(Mod.AP);
+        hasFullComboMod = Mods.Contains(Mod.FC);
+    }
+
     public bool IsJudged(int noteId) => Judgements[noteId].IsJudged;
 
     public NoteJudgement GetJudgement(int noteId) => Judgements[noteId];
 
     public void OnComplete()
     {
-        foreach (NoteGrade grade in Enum.GetValues(typeof(NoteGrade)))
+        for (var grade = NoteGrade.Miss; grade <= NoteGrade.Perfect; grade++)
         {
-            if (grade == NoteGrade.None) continue;
-            gradeCounts[grade] = Judgements.Count(it => it.Value.Grade == grade);
+            gradeCounts[grade] = judgedGradeCounts[(int) grade];
         }
+        // Notes that were never judged (e.g. after failing) count as misses
+        gradeCounts[NoteGrade.Miss] += Math.Max(0, NoteCount - ClearCount);
     }
 
     public void OnFail()
@@ -389,6 +439,70 @@ public sealed class GameState
 
     #region Health Mods
 
+    private struct HealthChange
+    {
+        public double Value;
+        public bool UseHealthBuffer;
+    }
+
+    private static readonly int NoteTypeCount = Enum.GetValues(typeof(NoteType)).Length;
+    private const int GradeCount = (int) NoteGrade.Perfect + 1;
+
+    private static int GetHealthChangeIndex(NoteType noteType, NoteGrade grade) => (int) noteType * GradeCount + (int) grade;
+
+    /**
+     * Looks up the health mod of a judgement through the mode's note and grading tables. Judge does not call this;
+     * it reads the table that BuildHealthChangeTable resolves from it.
+     */
+    public static HpMod SelectHpMod(GameMode mode, HashSet<Mod> mods, NoteType noteType, NoteGrade grade)
+    {
+        var modeMods = mods.Contains(Mod.ExHard) ? exHardHpMods : hardHpMods;
+        if (mode == GameMode.Tier) modeMods = tierHpMods;
+
+        return modeMods
+            .Select[noteType]
+            .Select[mode == GameMode.Practice ? unrankedGradingIndex[grade] : rankedGradingIndex[grade]];
+    }
+
+    /**
+     * Resolves the health mods of this state's mode and mods into a flat [note type][grade] table of health changes,
+     * so that Judge does not have to look them up.
+     */
+    private void BuildHealthChangeTable()
+    {
+        if (!UseHealthSystem) return;
+
+        healthChanges = new HealthChange[NoteTypeCount * GradeCount];
+        foreach (NoteType noteType in Enum.GetValues(typeof(NoteType)))
+        {
+            for (var grade = NoteGrade.Miss; grade <= NoteGrade.Perfect; grade++)
+            {
+                var mod = SelectHpMod(Mode, Mods, noteType, grade);
+
+                double change = 0;
+
+                switch (mod.Type)
+                {
+                    case HpModType.Absolute:
+                        change = mod.Value;
+                        break;
+                    case HpModType.Percentage:
+                        change = mod.Value / 100f * MaxHealth;
+                        break;
+                    case HpModType.DivideByNoteCount:
+                        change = mod.Value / NoteCount / 100f * MaxHealth;
+                        break;
+                }
+
+                healthChanges[GetHealthChangeIndex(noteType, grade)] = new HealthChange
+                {
+                    Value = change,
+                    UseHealthBuffer = mod.UseHealthBuffer
+                };
+            }
+        }
+    }
+
     private static Dictionary<NoteGrade, int> unrankedGradingIndex = new Dictionary<NoteGrade, int>
     {
         {NoteGrade.Perfect, 0},
@@ -686,13 +800,47 @@ public sealed class GameState
     #endregion
 }
 
-public class NoteJudgement
+public struct NoteJudgement
 {
     public bool IsJudged;
     public NoteGrade Grade;
     public double Error;
 }
 
+/**
+ * Count, mean and sum of squared deviations of a series, updated one value at a time (Welford's algorithm). Two series
+ * can be merged with Combine.
+ */
+public struct RunningStatistics
+{
+    public int Count;
+    public double Mean;
+    public double SquaredDeviationSum;
+
+    public double Variance => Count > 0 ? SquaredDeviationSum / Count : 0; // Population variance
+
+    public void Add(double value)
+    {
+        Count++;
+        var delta = value - Mean;
+        Mean += delta / Count;
+        SquaredDeviationSum += delta * (value - Mean);
+    }
+
+    public static RunningStatistics Combine(RunningStatistics a, RunningStatistics b)
+    {
+        var count = a.Count + b.Count;
+        if (count == 0) return default;
+        var delta = b.Mean - a.Mean;
+        return new RunningStatistics
+        {
+            Count = count,
+            Mean = a.Mean + delta * b.Count / count,
+            SquaredDeviationSum = a.SquaredDeviationSum + b.SquaredDeviationSum + delta * delta * a.Count * b.Count / count
+        };
+    }
+}
+
 public class ModeHpMod
 {
     public readonly Dictionary<NoteType, NoteHpMod> Select;
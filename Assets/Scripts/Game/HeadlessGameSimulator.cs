@@ -0,0 +1,373 @@
+using System;
+using System.Collections.Generic;
+
+public enum SimulatedInputType
+{
+    Touch, // Taps a note, starts flicking a flick note or presses a hold note
+    Flick, // Swipes a flick note that is being flicked
+    Release // Releases a hold note
+}
+
+public enum SimulatedInputTiming
+{
+    Exact, // Judged at the input's own time, as if inputs were timestamped
+    FrameTime, // Judged at the time of the frame that applies it
+    Estimated // Judged at the time InputController estimates for every input of the frame (see InputTiming)
+}
+
+public struct SimulatedInput
+{
+    public float Time;
+    public int NoteId;
+    public SimulatedInputType Type;
+
+    public SimulatedInput(float time, int noteId, SimulatedInputType type)
+    {
+        Time = time;
+        NoteId = noteId;
+        Type = type;
+    }
+}
+
+/**
+ * Plays a chart against a scripted input stream with a fixed-step clock, without any scene, camera, audio or rendering.
+ * Notes are judged by NoteJudging and GameState.Judge in the same order as Game.Update does it, so the resulting state
+ * (score, accuracy, combo, health) can be used for judgement regression checks and gameplay throughput benchmarks.
+ *
+ * Inputs are applied on the first frame at or after their time, like touches that are handled in the next Update. By
+ * default they are judged at their own time; set InputTimingMode to judge them at the frame time or at the time
+ * InputController would estimate, e.g. to compare how judgement error depends on FrameDuration.
+ *
+ * Hit-testing and the page checks of drag notes are not simulated; an input always targets its note directly.
+ */
+public class HeadlessGameSimulator
+{
+    public const float DefaultFrameDuration = 1 / 60f;
+
+    public Chart Chart { get; }
+    public GameState State { get; }
+    public float Time { get; private set; }
+    public int FrameCount { get; private set; }
+    public float FrameDuration { get; }
+    public float JudgmentOffset { get; }
+    public SimulatedInputTiming InputTimingMode { get; set; } = SimulatedInputTiming.Exact;
+
+    private readonly NoteTimingTable timings;
+    private readonly int[] spawnOrder; // Note ids sorted by intro time
+    private int spawnCursor;
+    private readonly List<int> activeNotes = new List<int>();
+    private readonly bool[] isCleared;
+    private readonly bool[] isHolding;
+    private readonly float[] holdingStartTimes;
+    private readonly float[] heldDurations;
+    private readonly float[] flickingStartTimes;
+    private readonly float endTime;
+
+    public HeadlessGameSimulator(
+        Chart chart,
+        GameMode mode,
+        HashSet<Mod> mods,
+        int difficultyLevel,
+        double? maxHealth = null,
+        float judgmentOffset = 0,
+        float frameDuration = DefaultFrameDuration)
+    {
+        if (frameDuration <= 0) throw new ArgumentOutOfRangeException(nameof(frameDuration));
+
+        Chart = chart;
+        State = new GameState(chart, mode, mods, difficultyLevel, maxHealth);
+        FrameDuration = frameDuration;
+        JudgmentOffset = judgmentOffset;
+
+        timings = chart.NoteTimings;
+        isCleared = new bool[timings.Count];
+        isHolding = new bool[timings.Count];
+        holdingStartTimes = new float[timings.Count];
+        heldDurations = new float[timings.Count];
+        flickingStartTimes = new float[timings.Count];
+
+        var notes = chart.Model.note_list;
+        spawnOrder = new int[notes.Count];
+        for (var i = 0; i < notes.Count; i++)
+        {
+            spawnOrder[i] = notes[i].id;
+            holdingStartTimes[notes[i].id] = float.MaxValue;
+            flickingStartTimes[notes[i].id] = float.MaxValue;
+            endTime = Math.Max(endTime,
+                notes[i].end_time + judgmentOffset + ((NoteType) notes[i].type).GetDefaultMissThreshold());
+        }
+        Array.Sort(spawnOrder, (a, b) => timings.IntroTimes[a].CompareTo(timings.IntroTimes[b]));
+
+        Time = Math.Min(0, spawnOrder.Length > 0 ? timings.IntroTimes[spawnOrder[0]] : 0);
+    }
+
+    /**
+     * Creates a chart with the default (non-inverted, unsmoothed) game config and a 16:9 screen. Display options that
+     * the chart does not set are filled in on the model with the default player settings, so that no player needs to
+     * be loaded.
+     */
+    public static Chart CreateChart(ChartModel model, bool useExperimentalNoteAr = false,
+        float approachRateMultiplier = 1f)
+    {
+        model.display_boundaries ??= false;
+        model.horizontal_margin ??= 3;
+        model.vertical_margin ??= 3;
+        model.restrict_play_area_aspect_ratio ??= true;
+        model.skip_music_on_completion ??= true;
+        return new Chart(model, false, false, false, useExperimentalNoteAr, approachRateMultiplier, 5f, 16 / 9f);
+    }
+
+    /**
+     * Inputs that hit every note exactly on time. Holds are pressed at their start time and held until they are judged.
+     */
+    public static List<SimulatedInput> CreatePerfectInputs(Chart chart)
+    {
+        var inputs = new List<SimulatedInput>(chart.Model.note_list.Count * 2);
+        foreach (var note in chart.Model.note_list)
+        {
+            inputs.Add(new SimulatedInput(note.start_time, note.id, SimulatedInputType.Touch));
+            if ((NoteType) note.type == NoteType.Flick)
+            {
+                inputs.Add(new SimulatedInput(note.start_time, note.id, SimulatedInputType.Flick));
+            }
+        }
+        SortInputs(inputs);
+        return inputs;
+    }
+
+    /**
+     * Sorts inputs by time; inputs at the same time keep their order.
+     */
+    public static void SortInputs(List<SimulatedInput> inputs)
+    {
+        var indexed = new KeyValuePair<int, SimulatedInput>[inputs.Count];
+        for (var i = 0; i < inputs.Count; i++) indexed[i] = new KeyValuePair<int, SimulatedInput>(i, inputs[i]);
+        Array.Sort(indexed, (a, b) =>
+        {
+            var result = a.Value.Time.CompareTo(b.Value.Time);
+            return result != 0 ? result : a.Key.CompareTo(b.Key);
+        });
+        for (var i = 0; i < inputs.Count; i++) inputs[i] = indexed[i].Value;
+    }
+
+    /**
+     * Runs the chart to completion (or failure) with the given inputs, which must be sorted by time.
+     */
+    public GameState Run(IReadOnlyList<SimulatedInput> inputs)
+    {
+        State.IsStarted = true;
+        State.IsPlaying = true;
+
+        var inputIndex = 0;
+        while (!State.IsCompleted && !State.IsFailed)
+        {
+            Time += FrameDuration;
+            FrameCount++;
+
+            while (spawnCursor < spawnOrder.Length && timings.IntroTimes[spawnOrder[spawnCursor]] <= Time)
+            {
+                activeNotes.Add(spawnOrder[spawnCursor++]);
+            }
+
+            while (inputIndex < inputs.Count && inputs[inputIndex].Time <= Time)
+            {
+                Apply(inputs[inputIndex++]);
+            }
+
+            for (var i = activeNotes.Count - 1; i >= 0; i--)
+            {
+                var id = activeNotes[i];
+                UpdateNote(id);
+                if (isCleared[id])
+                {
+                    activeNotes[i] = activeNotes[activeNotes.Count - 1];
+                    activeNotes.RemoveAt(activeNotes.Count - 1);
+                }
+            }
+
+            if (State.ShouldFail)
+            {
+                State.IsPlaying = false;
+                State.IsFailed = true;
+                break;
+            }
+
+            if (State.ClearCount >= State.NoteCount || Time > endTime)
+            {
+                State.IsPlaying = false;
+                State.IsCompleted = true;
+                State.OnComplete();
+            }
+        }
+
+        return State;
+    }
+
+    private void Apply(SimulatedInput input)
+    {
+        var id = input.NoteId;
+        if (id < 0 || id >= timings.Count || isCleared[id] || timings.IntroTimes[id] > Time) return;
+
+        // Inputs are never applied before their time, so this is at most one frame earlier than Time
+        float time;
+        switch (InputTimingMode)
+        {
+            case SimulatedInputTiming.FrameTime:
+                time = Time;
+                break;
+            case SimulatedInputTiming.Estimated:
+                time = (float) InputTiming.EstimateInputTime(Time, FrameDuration);
+                break;
+            default:
+                time = input.Time;
+                break;
+        }
+        var type = timings.Types[id];
+        switch (input.Type)
+        {
+            case SimulatedInputType.Touch:
+                switch (type)
+                {
+                    case NoteType.Hold:
+                    case NoteType.LongHold:
+                        if (!isHolding[id])
+                        {
+                            isHolding[id] = true;
+                            holdingStartTimes[id] = time;
+                        }
+                        break;
+                    case NoteType.Flick:
+                        if (flickingStartTimes[id] == float.MaxValue) flickingStartTimes[id] = time;
+                        break;
+                    case NoteType.DragHead:
+                    case NoteType.DragChild:
+                    case NoteType.CDragChild:
+                        // Do not handle touch event if touched too ahead of scanner
+                        if (timings.StartTimes[id] - time > 0.31f) return;
+                        TryClear(id, time);
+                        break;
+                    default:
+                        TryClear(id, time);
+                        break;
+                }
+                break;
+            case SimulatedInputType.Flick:
+                if (type == NoteType.Flick && flickingStartTimes[id] != float.MaxValue) TryClear(id, time);
+                break;
+            case SimulatedInputType.Release:
+                if ((type == NoteType.Hold || type == NoteType.LongHold) && isHolding[id])
+                {
+                    isHolding[id] = false;
+                    var startTime = timings.StartTimes[id] + JudgmentOffset;
+                    if (NoteJudging.ShouldJudgeHold(time, startTime))
+                    {
+                        heldDurations[id] = Math.Max(heldDurations[id],
+                            NoteJudging.GetHeldDuration(time, holdingStartTimes[id], startTime));
+                        ClearHold(id, time);
+                    }
+                }
+                break;
+        }
+    }
+
+    // Mirrors Note.OnGameUpdate and HoldNote.OnGameUpdate
+    private void UpdateNote(int id)
+    {
+        var type = timings.Types[id];
+        var isHold = type == NoteType.Hold || type == NoteType.LongHold;
+        var startTime = timings.StartTimes[id] + JudgmentOffset;
+
+        if (NoteJudging.ShouldAutoplay(State, type, timings.StartTimes[id] - Time))
+        {
+            if (isHold)
+            {
+                if (!isHolding[id])
+                {
+                    isHolding[id] = true;
+                    holdingStartTimes[id] = Time;
+                }
+            }
+            else
+            {
+                Clear(id, NoteGrade.Perfect, 0, Time);
+                return;
+            }
+        }
+
+        if (ShouldMiss(id, Time))
+        {
+            Clear(id, NoteGrade.Miss, 0, Time);
+            return;
+        }
+
+        if (isHold && isHolding[id])
+        {
+            heldDurations[id] = NoteJudging.GetHeldDuration(Time, holdingStartTimes[id], startTime);
+
+            // Already completed?
+            if (NoteJudging.IsHoldCompleted(Time, timings.EndTimes[id] + JudgmentOffset))
+            {
+                isHolding[id] = false;
+                if (NoteJudging.ShouldJudgeHold(Time, startTime)) ClearHold(id, Time);
+            }
+        }
+    }
+
+    // Mirrors Note.TryClear
+    private void TryClear(int id, float time)
+    {
+        if (NoteJudging.IsAutoEnabled(State, timings.Types[id])) Clear(id, NoteGrade.Perfect, 0, time);
+        if (ShouldMiss(id, time)) Clear(id, NoteGrade.Miss, 0, time);
+        var grade = CalculateGrade(id, time, out var greatGradeWeight);
+        if (grade != NoteGrade.None) Clear(id, grade, greatGradeWeight, time);
+    }
+
+    private void ClearHold(int id, float time)
+    {
+        if (NoteJudging.IsAutoEnabled(State, timings.Types[id]))
+        {
+            Clear(id, NoteGrade.Perfect, 0, time);
+            return;
+        }
+        var grade = CalculateGrade(id, time, out var greatGradeWeight);
+        Clear(id, grade, greatGradeWeight, time);
+    }
+
+    private bool ShouldMiss(int id, float time)
+    {
+        return NoteJudging.ShouldMiss(timings.StartTimes[id] + JudgmentOffset - time,
+            timings.Types[id].GetDefaultMissThreshold(), isHolding[id]);
+    }
+
+    private NoteGrade CalculateGrade(int id, float time, out float greatGradeWeight)
+    {
+        greatGradeWeight = 0;
+        var timeUntil = timings.StartTimes[id] + JudgmentOffset - time;
+        switch (timings.Types[id])
+        {
+            case NoteType.Hold:
+            case NoteType.LongHold:
+                return NoteJudging.GradeHold(State.Mode, timings.EndTimes[id] - timings.StartTimes[id],
+                    heldDurations[id], holdingStartTimes[id], timings.StartTimes[id] + JudgmentOffset,
+                    ref greatGradeWeight);
+            case NoteType.Flick:
+                if (ShouldMiss(id, time)) return NoteGrade.Miss;
+                return NoteJudging.GradeFlick(State.Mode, timeUntil);
+            case NoteType.DragHead:
+                return NoteJudging.GradeDragHead(timeUntil);
+            case NoteType.DragChild:
+            case NoteType.CDragChild:
+                return NoteJudging.GradeDragChild(timeUntil);
+            default:
+                return NoteJudging.GradeTap(State.Mode, timeUntil, ref greatGradeWeight);
+        }
+    }
+
+    private void Clear(int id, NoteGrade grade, float greatGradeWeight, float time)
+    {
+        if (isCleared[id]) return;
+        isCleared[id] = true;
+        isHolding[id] = false;
+        State.Judge(id, timings.Types[id], grade, time - timings.EndTimes[id], greatGradeWeight);
+    }
+}
@@ -1,6 +1,8 @@
 using System;
 using System.Collections.Generic;
+using System.IO;
 using System.Linq;
+using Cysharp.Threading.Tasks;
 using Lean.Touch;
 using UnityEngine;
 
@@ -10,18 +12,66 @@ public class InputController : MonoBehaviour
 
     public readonly Dictionary<int, FlickNote> FlickingNotes = new Dictionary<int, FlickNote>(); // Finger index to note
     public readonly Dictionary<int, HoldNote> HoldingNotes = new Dictionary<int, HoldNote>(); // Finger index to note
-    public readonly List<Note> TouchableDragNotes = new List<Note>(); // Drag head, Drag child, CDrag child
-    public readonly List<HoldNote> TouchableHoldNotes = new List<HoldNote>(); // Hold, Long hold
-    public readonly List<Note> TouchableNormalNotes = new List<Note>(); // Click, CDrag head, Hold, Long hold, Flick
+
+    // Emerged and uncleared notes, kept up to date by UpdateTouchable
+    public NoteSet<Note> TouchableDragNotes { get; private set; } // Drag head, Drag child, CDrag child
+    public NoteSet<HoldNote> TouchableHoldNotes { get; private set; } // Hold, Long hold (not being held)
+    public NoteSet<Note> TouchableNormalNotes { get; private set; } // Click, CDrag head, Hold, Long hold, Flick
+
+    private const int MaxSavedReplays = 20;
+
+    // Finger events of the current play, saved when the game ends; null in playback mode
+    public InputReplay Recording { get; private set; }
+
+    // Replay being fed through the finger handlers instead of LeanTouch
+    public InputReplay Playback { get; private set; }
+    private int playbackCursor;
+    private readonly Dictionary<int, LeanFinger> playbackFingers = new Dictionary<int, LeanFinger>();
+
+    // Spatial indices of the touchable sets above, refreshed after notes have moved each frame
+    private NoteSpatialGrid dragNoteGrid;
+    private NoteSpatialGrid holdNoteGrid;
+    private NoteSpatialGrid normalNoteGrid;
 
     private void Awake()
     {
+        game.onGameLoaded.AddListener(OnGameLoaded);
         game.onGameUpdate.AddListener(OnGameUpdate);
         game.onGamePaused.AddListener(OnGamePaused);
+        game.onGameCompleted.AddListener(SaveRecording);
+        game.onGameFailed.AddListener(SaveRecording);
+    }
+
+    private void OnGameLoaded(Game game)
+    {
+        // Play area at the depth touches are projected to
+        var min = game.camera.ViewportToWorldPoint(new Vector3(0, 0, 10));
+        var max = game.camera.ViewportToWorldPoint(new Vector3(1, 1, 10));
+        var area = Rect.MinMaxRect(Math.Min(min.x, max.x), Math.Min(min.y, max.y),
+            Math.Max(min.x, max.x), Math.Max(min.y, max.y));
+        // Roughly one default hitbox radius per cell
+        var cellSize = area.height / 8f;
+        var noteCapacity = game.Chart.Model.note_map.Length;
+        TouchableDragNotes = new NoteSet<Note>(noteCapacity);
+        TouchableHoldNotes = new NoteSet<HoldNote>(noteCapacity);
+        TouchableNormalNotes = new NoteSet<Note>(noteCapacity);
+        dragNoteGrid = new NoteSpatialGrid(area, cellSize, noteCapacity);
+        holdNoteGrid = new NoteSpatialGrid(area, cellSize, noteCapacity);
+        normalNoteGrid = new NoteSpatialGrid(area, cellSize, noteCapacity);
     }
 
     public void EnableInput()
     {
+        if (Recording == null)
+        {
+            Recording = new InputReplay
+            {
+                ChartChecksum = game.State.ChartChecksum,
+                Mods = new HashSet<Mod>(game.State.Mods),
+                ScreenWidth = Screen.width,
+                ScreenHeight = Screen.height
+            };
+        }
         LeanTouch.OnFingerDown += OnFingerDown;
         LeanTouch.OnFingerUpdate += OnFingerUpdate;
         LeanTouch.OnFingerUp += OnFingerUp;
@@ -32,6 +82,97 @@ public class InputController : MonoBehaviour
         LeanTouch.OnFingerDown -= OnFingerDown;
         LeanTouch.OnFingerUpdate -= OnFingerUpdate;
         LeanTouch.OnFingerUp -= OnFingerUp;
+        Playback = null;
+    }
+
+    /**
+     * Feeds the finger events of the replay through the finger handlers, at their recorded times, instead of
+     * listening to LeanTouch. Nothing is recorded in playback mode.
+     */
+    public void StartPlayback(InputReplay replay)
+    {
+        Playback = replay;
+        playbackCursor = 0;
+        playbackFingers.Clear();
+    }
+
+    private void OnGameUpdate(Game game)
+    {
+        if (Playback == null || !game.State.IsPlaying) return;
+
+        var events = Playback.Events;
+        var scale = new Vector2(
+            Playback.ScreenWidth > 0 ? (float) Screen.width / Playback.ScreenWidth : 1,
+            Playback.ScreenHeight > 0 ? (float) Screen.height / Playback.ScreenHeight : 1);
+        while (Playback != null && playbackCursor < events.Count && events[playbackCursor].Time <= game.Time)
+        {
+            var it = events[playbackCursor++];
+            if (!playbackFingers.TryGetValue(it.FingerIndex, out var finger))
+            {
+                finger = new LeanFinger {Index = it.FingerIndex};
+                playbackFingers[it.FingerIndex] = finger;
+            }
+
+            var position = Vector2.Scale(it.ScreenPosition, scale);
+            finger.LastScreenPosition = it.Type == InputReplay.FingerEventType.Down ? position : finger.ScreenPosition;
+            finger.ScreenPosition = position;
+            switch (it.Type)
+            {
+                case InputReplay.FingerEventType.Down:
+                    finger.StartScreenPosition = position;
+                    HandleFingerDown(finger, it.Time);
+                    break;
+                case InputReplay.FingerEventType.Update:
+                    HandleFingerUpdate(finger, it.Time);
+                    break;
+                case InputReplay.FingerEventType.Up:
+                    HandleFingerUp(finger, it.Time);
+                    break;
+            }
+        }
+    }
+
+    private void Record(InputReplay.FingerEventType type, LeanFinger finger, float time)
+    {
+        if (!game.State.IsPlaying) return;
+        Recording?.Events.Add(new InputReplay.FingerEvent
+        {
+            Type = type,
+            FingerIndex = finger.Index,
+            Time = time,
+            ScreenPosition = finger.ScreenPosition
+        });
+    }
+
+    private void SaveRecording(Game game)
+    {
+        var recording = Recording;
+        Recording = null;
+        if (recording == null || recording.Events.Count == 0) return;
+
+        var directory = Path.Combine(Context.UserDataPath, ".replays");
+        var path = Path.Combine(directory,
+            $"{game.Level.Id}_{game.Difficulty.Id}_{DateTime.UtcNow:yyyyMMdd'T'HHmmss}.replay");
+        UniTask.RunOnThreadPool(() =>
+        {
+            try
+            {
+                recording.Save(path);
+
+                // Only keep the latest replays
+                foreach (var file in new DirectoryInfo(directory).GetFiles("*.replay")
+                    .OrderByDescending(it => it.LastWriteTimeUtc)
+                    .Skip(MaxSavedReplays))
+                {
+                    file.Delete();
+                }
+            }
+            catch (Exception e)
+            {
+                Debug.LogWarning($"Could not save input replay {path}");
+                Debug.LogWarning(e);
+            }
+        }).Forget();
     }
 
     public void OnNoteCollected(Note note)
@@ -46,83 +187,155 @@ public class InputController : MonoBehaviour
             // Since you only have 10 fingers, this doesn't need to be optimized
             FlickingNotes.RemoveAll(it => it == note);
         }
+        SetTouchable(note, false, false);
+    }
+
+    /**
+     * Updates the touchable sets after the note has emerged, been cleared (or reset in the player), or started or
+     * stopped being held.
+     */
+    public void UpdateTouchable(Note note)
+    {
+        SetTouchable(note, note.IsTouchable, note is HoldNote holdNote && holdNote.IsHolding);
+    }
+
+    private void SetTouchable(Note note, bool isTouchable, bool isHolding)
+    {
+        if (TouchableDragNotes == null) return;
+
+        if (note.Type == NoteType.DragHead || note.Type == NoteType.DragChild || note.Type == NoteType.CDragChild)
+        {
+            SetMembership(TouchableDragNotes, dragNoteGrid, note, isTouchable);
+        }
+        else
+        {
+            SetMembership(TouchableNormalNotes, normalNoteGrid, note, isTouchable);
+        }
+
+        if (note.Type == NoteType.Hold || note.Type == NoteType.LongHold)
+        {
+            SetMembership(TouchableHoldNotes, holdNoteGrid, (HoldNote) note, isTouchable && !isHolding);
+        }
+    }
+
+    private static void SetMembership<T>(NoteSet<T> set, NoteSpatialGrid grid, T note, bool isMember) where T : Note
+    {
+        if (isMember)
+        {
+            set.Add(note); // Registered in the grid by the next UpdateGrids, after the note has moved
+        }
+        else if (set.Remove(note))
+        {
+            grid.Remove(note);
+        }
     }
 
     public void OnGamePaused(Game game)
     {
-        HoldingNotes.Values.ForEach(note =>
+        foreach (var note in HoldingNotes.Values)
         {
             note.HoldingFingers.Clear();
-        });
+            UpdateTouchable(note);
+        }
         HoldingNotes.Clear();
     }
 
-    public void OnGameUpdate(Game game)
+    /**
+     * Moves the touchable notes to their current positions in the grids. Called by Game.Update after
+     * NoteUpdateScheduler.LateUpdate, which moves drag heads along their chains.
+     */
+    public void UpdateGrids()
     {
-        TouchableNormalNotes.Clear();
-        TouchableDragNotes.Clear();
-        TouchableHoldNotes.Clear();
-        foreach (var id in game.SpawnedNotes.Keys)
-        {
-            var note = game.SpawnedNotes[id];
-            if (!note.HasEmerged || note.IsCleared) continue;
+        if (dragNoteGrid == null) return;
+        UpdateGrid(dragNoteGrid, TouchableDragNotes);
+        UpdateGrid(holdNoteGrid, TouchableHoldNotes);
+        UpdateGrid(normalNoteGrid, TouchableNormalNotes);
+    }
 
-            if (note.Type != NoteType.DragHead && note.Type != NoteType.DragChild && note.Type != NoteType.CDragChild)
-            {
-                TouchableNormalNotes.Add(note);
-            } 
-            else 
-            {
-                TouchableDragNotes.Add(note);
-            }
+    private static void UpdateGrid<T>(NoteSpatialGrid grid, NoteSet<T> notes) where T : Note
+    {
+        for (var i = 0; i < notes.Count; i++)
+        {
+            var note = notes[i];
+            if (note == null) continue;
+            var collider = note.Renderer.GetCollider();
+            var transform = collider.transform;
+            var scale = transform.lossyScale;
+            grid.Set(note, transform.TransformPoint(collider.offset),
+                collider.radius * Math.Max(Math.Abs(scale.x), Math.Abs(scale.y)));
+        }
+    }
 
-            if ((note.Type == NoteType.Hold || note.Type == NoteType.LongHold) &&
-                !((HoldNote) note).IsHolding)
-            {
-                TouchableHoldNotes.Add((HoldNote) note);
-            }
+    private static Note FindCollidingNote(NoteSpatialGrid grid, Vector2 position)
+    {
+        var candidates = grid.Query(position);
+        for (var i = 0; i < candidates.Count; i++)
+        {
+            var note = candidates[i];
+            if (note != null && note.DoesCollide(position)) return note;
         }
+        return null;
+    }
 
-        // // Make sure to query non-flick notes first
-        // TouchableNormalNotes.Sort((a, b) =>
-        // {
-        //     if (a.GetType() == b.GetType()) return a.Model.id - b.Model.id;
-        //     if (a is FlickNote) return 1;
-        //     return -1;
-        // });
+    /**
+     * Chart time at which the touches reported in this frame are judged. This is not the time of each touch: LeanTouch
+     * reads the legacy input manager, which has no event timestamps (the Input System package and its InputEvent.time
+     * are not part of this project), so every touch of a frame gets the same estimate, the middle of the interval since
+     * the previous poll (see InputTiming). A touch may be off by up to half a frame either way; in frames longer than
+     * InputTiming.MaxPollInterval, it may also have happened up to the rest of the frame earlier.
+     */
+    protected virtual float GetInputTime()
+    {
+        var time = game.GetTimeAt(InputTiming.EstimateInputTime(UnityEngine.Time.unscaledTimeAsDouble,
+            UnityEngine.Time.unscaledDeltaTime));
+        // Game.Time may have been set without being sampled (e.g. seeking in the player)
+        return Mathf.Clamp(time, game.Time - InputTiming.MaxPollInterval, game.Time + InputTiming.MaxPollInterval);
     }
 
     protected virtual void OnFingerDown(LeanFinger finger)
+    {
+        var time = GetInputTime();
+        Record(InputReplay.FingerEventType.Down, finger, time);
+        HandleFingerDown(finger, time);
+    }
+
+    protected virtual void HandleFingerDown(LeanFinger finger, float time)
     {
         var pressedPosition = game.camera.orthographic
             ? game.camera.ScreenToWorldPoint(finger.ScreenPosition)
             : game.camera.ScreenToWorldPoint(new Vector3(finger.ScreenPosition.x, finger.ScreenPosition.y, 10));
 
+        if (dragNoteGrid == null) return;
+
         var collidedDrag = false;
         // Query drag notes first
-        foreach (var note in TouchableDragNotes.Where(note => note != null).Where(note => note.DoesCollide(pressedPosition)))
+        var dragNote = FindCollidingNote(dragNoteGrid, pressedPosition);
+        if (dragNote != null)
         {
-            note.OnTouch(finger.ScreenPosition);
+            dragNote.OnTouch(finger.ScreenPosition, time);
             collidedDrag = true;
-            break; // Query other notes too!
+            // Query other notes too!
         }
 
-        foreach (var note in TouchableNormalNotes.Where(note => note != null).Where(note => note.DoesCollide(pressedPosition)))
+        var candidates = normalNoteGrid.Query(pressedPosition);
+        for (var i = 0; i < candidates.Count; i++)
         {
+            var note = candidates[i];
+            if (note == null || !note.DoesCollide(pressedPosition)) continue;
             if (note is FlickNote flickNote)
             {
                 if (FlickingNotes.ContainsKey(finger.Index) || FlickingNotes.ContainsValue(flickNote))
                     continue;
                 FlickingNotes.Add(finger.Index, flickNote);
-                flickNote.StartFlicking(pressedPosition);
+                flickNote.StartFlicking(pressedPosition, time);
             }
             else
             {
                 if (collidedDrag && Math.Abs(note.TimeUntilStart) > note.Page.Duration / 8f) continue;
-                if (note.Model.page_index > game.Chart.CurrentPageId &&
-                    note.Model.start_time - game.Time >
+                if (note.Timings.PageIndices[note.Id] > game.Chart.CurrentPageId &&
+                    note.TimeUntilStart >
                     game.Chart.Model.page_list[game.Chart.CurrentPageId].Duration * 0.5f) continue;
-                note.OnTouch(finger.ScreenPosition);
+                note.OnTouch(finger.ScreenPosition, time);
             }
 
             return;
@@ -130,6 +343,13 @@ public class InputController : MonoBehaviour
     }
 
     protected virtual void OnFingerUpdate(LeanFinger finger)
+    {
+        var time = GetInputTime();
+        Record(InputReplay.FingerEventType.Update, finger, time);
+        HandleFingerUpdate(finger, time);
+    }
+
+    protected virtual void HandleFingerUpdate(LeanFinger finger, float time)
     {
         var pos = game.camera.orthographic
             ? game.camera.ScreenToWorldPoint(finger.ScreenPosition)
@@ -139,19 +359,17 @@ public class InputController : MonoBehaviour
         if (FlickingNotes.ContainsKey(finger.Index))
         {
             var flickingNote = FlickingNotes[finger.Index];
-            var cleared = flickingNote.UpdateFingerPosition(pos);
+            var cleared = flickingNote.UpdateFingerPosition(pos, time);
             if (cleared) FlickingNotes.Remove(finger.Index);
         }
 
+        if (dragNoteGrid == null) return;
+
         // Query drag notes
-        foreach (var note in TouchableDragNotes)
+        var dragNote = FindCollidingNote(dragNoteGrid, pos);
+        if (dragNote != null)
         {
-            if (note == null) continue;
-            if (note.DoesCollide(pos))
-            {
-                note.OnTouch(finger.ScreenPosition);
-                break; // Query other notes too!
-            }
+            dragNote.OnTouch(finger.ScreenPosition, time); // Query other notes too!
         }
 
         // If this is a new finger
@@ -160,25 +378,22 @@ public class InputController : MonoBehaviour
             var switchedToNewNote = false; // If the finger holds a new note
 
             // Query unheld hold notes
-            foreach (var note in TouchableHoldNotes)
+            var note = (HoldNote) FindCollidingNote(holdNoteGrid, pos);
+            if (note != null)
             {
-                if (note == null) continue;
-                if (note.DoesCollide(pos))
-                {
-                    HoldingNotes.Add(finger.Index, note);
-                    note.UpdateFinger(finger.Index, true);
-                    switchedToNewNote = true;
-                    break;
-                }
+                HoldingNotes.Add(finger.Index, note);
+                note.UpdateFinger(finger.Index, true, time);
+                switchedToNewNote = true;
             }
 
             // Query held hold notes (i.e. multiple fingers on the same hold note)
             if (!switchedToNewNote)
             {
-                foreach (var holdNote in HoldingNotes.Values.Where(holdNote => holdNote.DoesCollide(pos)))
+                foreach (var holdNote in HoldingNotes.Values)
                 {
+                    if (!holdNote.DoesCollide(pos)) continue;
                     HoldingNotes.Add(finger.Index, holdNote);
-                    holdNote.UpdateFinger(finger.Index, true);
+                    holdNote.UpdateFinger(finger.Index, true, time);
                     break;
                 }
             }
@@ -194,18 +409,25 @@ public class InputController : MonoBehaviour
             }
             else if (!holdNote.DoesCollide(pos)) // If holding elsewhere
             {
-                holdNote.UpdateFinger(finger.Index, false);
+                holdNote.UpdateFinger(finger.Index, false, time);
                 HoldingNotes.Remove(finger.Index);
             }
         }
     }
 
     protected virtual void OnFingerUp(LeanFinger finger)
+    {
+        var time = GetInputTime();
+        Record(InputReplay.FingerEventType.Up, finger, time);
+        HandleFingerUp(finger, time);
+    }
+
+    protected virtual void HandleFingerUp(LeanFinger finger, float time)
     {
         if (HoldingNotes.ContainsKey(finger.Index))
         {
             var holdNote = HoldingNotes[finger.Index];
-            holdNote.UpdateFinger(finger.Index, false);
+            holdNote.UpdateFinger(finger.Index, false, time);
             HoldingNotes.Remove(finger.Index);
         }
         if (FlickingNotes.ContainsKey(finger.Index))
@@ -215,7 +437,7 @@ public class InputController : MonoBehaviour
                 : game.camera.ScreenToWorldPoint(new Vector3(finger.ScreenPosition.x, finger.ScreenPosition.y, 10));
             
             var flickingNote = FlickingNotes[finger.Index];
-            flickingNote.UpdateFingerPosition(pos);
+            flickingNote.UpdateFingerPosition(pos, time);
             FlickingNotes.Remove(finger.Index);
         }
     }
@@ -0,0 +1,164 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+using UnityEngine;
+
+/**
+ * Finger events of one play, recorded by InputController and fed back through it in playback mode.
+ *
+ * Binary format: header (magic, version, chart checksum, mods, screen size), followed by the events. Each event is a
+ * type byte and zigzag varints for the finger index, the time delta to the previous event (in microseconds) and the
+ * screen position delta to the previous event of the same finger (in 1/8 pixels).
+ */
+public class InputReplay
+{
+    public enum FingerEventType : byte
+    {
+        Down = 0,
+        Update = 1,
+        Up = 2
+    }
+
+    public struct FingerEvent
+    {
+        public FingerEventType Type;
+        public int FingerIndex;
+        public float Time; // Chart time at which the event is judged
+        public Vector2 ScreenPosition;
+    }
+
+    private const int Magic = 0x50525943; // "CYRP"
+    private const int Version = 1;
+    private const double TimeUnitsPerSecond = 1000000;
+    private const float PositionUnitsPerPixel = 8;
+
+    public string ChartChecksum { get; set; }
+    public HashSet<Mod> Mods { get; set; } = new HashSet<Mod>();
+    public int ScreenWidth { get; set; }
+    public int ScreenHeight { get; set; }
+    public List<FingerEvent> Events { get; } = new List<FingerEvent>(4096);
+
+    public void Save(string path)
+    {
+        Directory.CreateDirectory(Path.GetDirectoryName(path));
+        using (var stream = File.Create(path))
+        {
+            Write(stream);
+        }
+    }
+
+    public static InputReplay Load(string path)
+    {
+        using (var stream = File.OpenRead(path))
+        {
+            return Read(stream);
+        }
+    }
+
+    public void Write(Stream stream)
+    {
+        using (var writer = new BinaryWriter(stream, Encoding.UTF8, true))
+        {
+            writer.Write(Magic);
+            writer.Write(Version);
+            writer.Write(ChartChecksum ?? "");
+            writer.Write(Mods.Count);
+            foreach (var mod in Mods) writer.Write(mod.ToString());
+            writer.Write(ScreenWidth);
+            writer.Write(ScreenHeight);
+
+            writer.Write(Events.Count);
+            long lastTime = 0;
+            var lastPositions = new Dictionary<int, (long, long)>();
+            foreach (var it in Events)
+            {
+                var time = (long) Math.Round(it.Time * TimeUnitsPerSecond);
+                var x = (long) Math.Round(it.ScreenPosition.x * PositionUnitsPerPixel);
+                var y = (long) Math.Round(it.ScreenPosition.y * PositionUnitsPerPixel);
+                lastPositions.TryGetValue(it.FingerIndex, out var lastPosition);
+
+                writer.Write((byte) it.Type);
+                WriteVarInt(writer, it.FingerIndex);
+                WriteVarInt(writer, time - lastTime);
+                WriteVarInt(writer, x - lastPosition.Item1);
+                WriteVarInt(writer, y - lastPosition.Item2);
+
+                lastTime = time;
+                lastPositions[it.FingerIndex] = (x, y);
+            }
+        }
+    }
+
+    public static InputReplay Read(Stream stream)
+    {
+        using (var reader = new BinaryReader(stream, Encoding.UTF8, true))
+        {
+            if (reader.ReadInt32() != Magic) throw new InvalidDataException("Not an input replay");
+            var version = reader.ReadInt32();
+            if (version != Version) throw new InvalidDataException($"Unsupported input replay version {version}");
+
+            var replay = new InputReplay {ChartChecksum = reader.ReadString()};
+            var modCount = reader.ReadInt32();
+            for (var i = 0; i < modCount; i++)
+            {
+                var name = reader.ReadString();
+                if (Enum.TryParse(name, out Mod mod)) replay.Mods.Add(mod);
+                else Debug.LogWarning($"Unknown mod {name} in input replay");
+            }
+            replay.ScreenWidth = reader.ReadInt32();
+            replay.ScreenHeight = reader.ReadInt32();
+
+            var eventCount = reader.ReadInt32();
+            replay.Events.Capacity = eventCount;
+            long time = 0;
+            var lastPositions = new Dictionary<int, (long, long)>();
+            for (var i = 0; i < eventCount; i++)
+            {
+                var type = (FingerEventType) reader.ReadByte();
+                var fingerIndex = (int) ReadVarInt(reader);
+                time += ReadVarInt(reader);
+                lastPositions.TryGetValue(fingerIndex, out var lastPosition);
+                var x = lastPosition.Item1 + ReadVarInt(reader);
+                var y = lastPosition.Item2 + ReadVarInt(reader);
+                lastPositions[fingerIndex] = (x, y);
+
+                replay.Events.Add(new FingerEvent
+                {
+                    Type = type,
+                    FingerIndex = fingerIndex,
+                    Time = (float) (time / TimeUnitsPerSecond),
+                    ScreenPosition = new Vector2(x / PositionUnitsPerPixel, y / PositionUnitsPerPixel)
+                });
+            }
+
+            return replay;
+        }
+    }
+
+    private static void WriteVarInt(BinaryWriter writer, long value)
+    {
+        var zigzag = (ulong) ((value << 1) ^ (value >> 63));
+        while (zigzag >= 0x80)
+        {
+            writer.Write((byte) (zigzag | 0x80));
+            zigzag >>= 7;
+        }
+        writer.Write((byte) zigzag);
+    }
+
+    private static long ReadVarInt(BinaryReader reader)
+    {
+        ulong zigzag = 0;
+        var shift = 0;
+        byte b;
+        do
+        {
+            if (shift > 63) throw new InvalidDataException("Malformed varint");
+            b = reader.ReadByte();
+            zigzag |= (ulong) (b & 0x7F) << shift;
+            shift += 7;
+        } while ((b & 0x80) != 0);
+        return (long) (zigzag >> 1) ^ -(long) (zigzag & 1);
+    }
+}
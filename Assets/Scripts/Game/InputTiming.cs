@@ -0,0 +1,21 @@
+using System;
+
+/**
+ * Estimates when an untimestamped input happened. The legacy input manager polls touches once per frame, so a touch
+ * reported by a poll happened at some point since the previous poll; it is judged at the middle of that interval. This
+ * is one estimate per poll rather than a time per input event: it is unbiased, but its error still spreads over up to
+ * half a poll interval either way, so it grows with the frame duration.
+ */
+public static class InputTiming
+{
+    // Frames longer than this (e.g. hitches) are not assumed to have delayed their inputs by more than half of it
+    public const float MaxPollInterval = 1 / 30f;
+
+    /**
+     * pollTime is when the input was reported and pollInterval the time since the previous poll, both in any clock.
+     */
+    public static double EstimateInputTime(double pollTime, float pollInterval)
+    {
+        return pollTime - Math.Min(pollInterval, MaxPollInterval) * 0.5;
+    }
+}
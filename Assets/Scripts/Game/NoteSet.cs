@@ -0,0 +1,61 @@
+using System;
+
+/**
+ * Set of notes with O(1) add, remove and lookup by note id. Notes are stored densely and enumerated by index, which
+ * does not allocate; removal swaps the last note into the freed slot, so the order is not preserved.
+ */
+public class NoteSet<T> where T : Note
+{
+    private T[] notes = new T[32];
+    private int count;
+    private readonly int[] indices; // Indexed by note id; -1 if absent
+
+    public int Count => count;
+
+    public T this[int index] => notes[index];
+
+    public NoteSet(int noteCapacity)
+    {
+        indices = new int[noteCapacity];
+        for (var i = 0; i < noteCapacity; i++) indices[i] = -1;
+    }
+
+    public bool Contains(T note) => indices[note.Id] >= 0;
+
+    /**
+     * Returns false if the note is already in the set.
+     */
+    public bool Add(T note)
+    {
+        if (indices[note.Id] >= 0) return false;
+        if (count == notes.Length) Array.Resize(ref notes, notes.Length * 2);
+        indices[note.Id] = count;
+        notes[count++] = note;
+        return true;
+    }
+
+    /**
+     * Returns false if the note is not in the set.
+     */
+    public bool Remove(T note)
+    {
+        var index = indices[note.Id];
+        if (index < 0) return false;
+        var last = notes[--count];
+        notes[index] = last;
+        indices[last.Id] = index;
+        notes[count] = null;
+        indices[note.Id] = -1;
+        return true;
+    }
+
+    public void Clear()
+    {
+        for (var i = 0; i < count; i++)
+        {
+            indices[notes[i].Id] = -1;
+            notes[i] = null;
+        }
+        count = 0;
+    }
+}
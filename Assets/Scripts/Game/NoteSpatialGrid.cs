@@ -0,0 +1,140 @@
+using System;
+using System.Collections.Generic;
+using UnityEngine;
+
+/**
+ * Uniform grid over the play area (world space) that returns the notes whose hitbox may contain a point. A note is
+ * registered in every cell overlapped by the bounding box of its hitbox, and its cells are only touched again when it
+ * moves into a different range of cells. Points and hitboxes outside the play area are clamped to the border cells.
+ *
+ * Each cell keeps its notes sorted by note id, which is the order InputController has always queried notes in.
+ */
+public class NoteSpatialGrid
+{
+    private struct CellRange
+    {
+        public int MinX, MinY, MaxX, MaxY;
+    }
+
+    private static readonly IComparer<Note> IdComparer = Comparer<Note>.Create((a, b) => a.Id.CompareTo(b.Id));
+
+    private readonly Vector2 origin;
+    private readonly float inverseCellSize;
+    private readonly int columns;
+    private readonly int rows;
+    private readonly List<Note>[] cells;
+
+    // Indexed by note id
+    private readonly CellRange[] ranges;
+    private readonly int[] registeredIndices;
+
+    private readonly List<Note> registered = new List<Note>();
+
+    public int Count => registered.Count;
+
+    public NoteSpatialGrid(Rect area, float cellSize, int noteCapacity)
+    {
+        origin = area.min;
+        inverseCellSize = 1f / cellSize;
+        columns = Math.Max(1, Mathf.CeilToInt(area.width * inverseCellSize));
+        rows = Math.Max(1, Mathf.CeilToInt(area.height * inverseCellSize));
+        cells = new List<Note>[columns * rows];
+        for (var i = 0; i < cells.Length; i++) cells[i] = new List<Note>(4);
+
+        ranges = new CellRange[noteCapacity];
+        registeredIndices = new int[noteCapacity];
+        for (var i = 0; i < noteCapacity; i++) registeredIndices[i] = -1;
+    }
+
+    /**
+     * Registers the note with a circular hitbox, or moves it if its cells have changed.
+     */
+    public void Set(Note note, Vector2 center, float radius)
+    {
+        var id = note.Id;
+
+        var range = new CellRange
+        {
+            MinX = ToColumn(center.x - radius),
+            MinY = ToRow(center.y - radius),
+            MaxX = ToColumn(center.x + radius),
+            MaxY = ToRow(center.y + radius)
+        };
+
+        if (registeredIndices[id] >= 0)
+        {
+            var current = ranges[id];
+            if (current.MinX == range.MinX && current.MinY == range.MinY &&
+                current.MaxX == range.MaxX && current.MaxY == range.MaxY) return;
+            RemoveFromCells(note, current);
+        }
+        else
+        {
+            registeredIndices[id] = registered.Count;
+            registered.Add(note);
+        }
+
+        ranges[id] = range;
+        for (var y = range.MinY; y <= range.MaxY; y++)
+        {
+            for (var x = range.MinX; x <= range.MaxX; x++)
+            {
+                var cell = cells[y * columns + x];
+                var index = cell.BinarySearch(note, IdComparer);
+                cell.Insert(index < 0 ? ~index : index, note);
+            }
+        }
+    }
+
+    public void Remove(Note note)
+    {
+        var id = note.Id;
+        var index = registeredIndices[id];
+        if (index < 0) return;
+
+        RemoveFromCells(note, ranges[id]);
+
+        var last = registered[registered.Count - 1];
+        registered[index] = last;
+        registeredIndices[last.Id] = index;
+        registered.RemoveAt(registered.Count - 1);
+        registeredIndices[id] = -1;
+    }
+
+    public void Clear()
+    {
+        foreach (var note in registered) registeredIndices[note.Id] = -1;
+        registered.Clear();
+        foreach (var cell in cells) cell.Clear();
+    }
+
+    /**
+     * Returns the candidates for a point, sorted by note id. The returned list is owned by the grid and must not be
+     * modified; it is only valid until the next Set or Remove.
+     */
+    public List<Note> Query(Vector2 point)
+    {
+        return cells[ToRow(point.y) * columns + ToColumn(point.x)];
+    }
+
+    private void RemoveFromCells(Note note, CellRange range)
+    {
+        for (var y = range.MinY; y <= range.MaxY; y++)
+        {
+            for (var x = range.MinX; x <= range.MaxX; x++)
+            {
+                cells[y * columns + x].Remove(note);
+            }
+        }
+    }
+
+    private int ToColumn(float x) => ToCell((x - origin.x) * inverseCellSize, columns);
+
+    private int ToRow(float y) => ToCell((y - origin.y) * inverseCellSize, rows);
+
+    private static int ToCell(float position, int count)
+    {
+        if (!(position > 0)) return 0; // Also catches NaN
+        return position >= count ? count - 1 : (int) position;
+    }
+}
@@ -0,0 +1,164 @@
+using System;
+using System.Collections.Generic;
+using UnityEngine;
+
+/**
+ * Drives the per-frame updates of spawned notes and drag lines from dense arrays, instead of registering each of them
+ * as a listener of Game.onGameUpdate/onGameLateUpdate (whose invocation lists are rebuilt on every add/remove).
+ *
+ * Elements are removed in O(1) by swapping the last element into their slot. Removals requested while the per-element
+ * updates run (e.g. a note or drag line collecting itself, or another element) are deferred until all of them have run,
+ * so that every element registered when an update starts is updated exactly once in it, as the listeners of a UnityEvent
+ * were. Elements added meanwhile are first updated in the next update.
+ *
+ * Note transforms are updated in batches: the positions (and in LateUpdate, the rotations) of all notes are computed
+ * first, then written to the transforms in a single pass, and only then are the per-note updates invoked. The
+ * calculations do not touch the engine, so they stay out of the write-back loop.
+ */
+public class NoteUpdateScheduler
+{
+    private Note[] notes = new Note[64];
+    private int noteCount;
+    private bool[] hasPosition = new bool[64];
+    private Vector3[] rotations = new Vector3[64];
+    private DragLineElement[] dragLines = new DragLineElement[64];
+    private int dragLineCount;
+    private bool isInvoking;
+    private readonly List<Note> pendingNoteRemovals = new List<Note>();
+    private readonly List<DragLineElement> pendingDragLineRemovals = new List<DragLineElement>();
+
+    public int NoteCount => noteCount;
+    public int DragLineCount => dragLineCount;
+
+    public void Add(Note note)
+    {
+        if (note.SchedulerIndex >= 0)
+        {
+            // Collected and reused during the same update
+            if (isInvoking) pendingNoteRemovals.Remove(note);
+            return;
+        }
+        if (noteCount == notes.Length)
+        {
+            Array.Resize(ref notes, notes.Length * 2);
+            Array.Resize(ref hasPosition, notes.Length);
+            Array.Resize(ref rotations, notes.Length);
+        }
+        note.SchedulerIndex = noteCount;
+        notes[noteCount++] = note;
+    }
+
+    public void Remove(Note note)
+    {
+        var index = note.SchedulerIndex;
+        if (index < 0) return;
+        if (isInvoking)
+        {
+            if (!pendingNoteRemovals.Contains(note)) pendingNoteRemovals.Add(note);
+            return;
+        }
+        var last = notes[--noteCount];
+        notes[index] = last;
+        last.SchedulerIndex = index;
+        notes[noteCount] = null;
+        note.SchedulerIndex = -1;
+    }
+
+    public void Add(DragLineElement dragLine)
+    {
+        if (dragLine.SchedulerIndex >= 0)
+        {
+            if (isInvoking) pendingDragLineRemovals.Remove(dragLine);
+            return;
+        }
+        if (dragLineCount == dragLines.Length) Array.Resize(ref dragLines, dragLines.Length * 2);
+        dragLine.SchedulerIndex = dragLineCount;
+        dragLines[dragLineCount++] = dragLine;
+    }
+
+    public void Remove(DragLineElement dragLine)
+    {
+        var index = dragLine.SchedulerIndex;
+        if (index < 0) return;
+        if (isInvoking)
+        {
+            if (!pendingDragLineRemovals.Contains(dragLine)) pendingDragLineRemovals.Add(dragLine);
+            return;
+        }
+        var last = dragLines[--dragLineCount];
+        dragLines[index] = last;
+        last.SchedulerIndex = index;
+        dragLines[dragLineCount] = null;
+        dragLine.SchedulerIndex = -1;
+    }
+
+    public void Update()
+    {
+        for (var i = 0; i < noteCount; i++)
+        {
+            hasPosition[i] = notes[i].UpdateLocalPosition();
+        }
+        for (var i = 0; i < noteCount; i++)
+        {
+            if (hasPosition[i]) notes[i].transform.localPosition = notes[i].LocalPosition;
+        }
+        isInvoking = true;
+        try
+        {
+            for (var i = noteCount - 1; i >= 0; i--) notes[i].InvokeGameUpdate();
+            for (var i = dragLineCount - 1; i >= 0; i--) dragLines[i].InvokeGameUpdate();
+        }
+        finally
+        {
+            RemovePending();
+        }
+    }
+
+    public void LateUpdate()
+    {
+        for (var i = 0; i < noteCount; i++)
+        {
+            rotations[i] = notes[i].UpdateRotation();
+        }
+        for (var i = 0; i < noteCount; i++)
+        {
+            notes[i].transform.localEulerAngles = rotations[i];
+        }
+        isInvoking = true;
+        try
+        {
+            for (var i = noteCount - 1; i >= 0; i--) notes[i].InvokeGameLateUpdate();
+        }
+        finally
+        {
+            RemovePending();
+        }
+    }
+
+    private void RemovePending()
+    {
+        isInvoking = false;
+        foreach (var note in pendingNoteRemovals) Remove(note);
+        foreach (var dragLine in pendingDragLineRemovals) Remove(dragLine);
+        pendingNoteRemovals.Clear();
+        pendingDragLineRemovals.Clear();
+    }
+
+    public void Clear()
+    {
+        for (var i = 0; i < noteCount; i++)
+        {
+            notes[i].SchedulerIndex = -1;
+            notes[i] = null;
+        }
+        for (var i = 0; i < dragLineCount; i++)
+        {
+            dragLines[i].SchedulerIndex = -1;
+            dragLines[i] = null;
+        }
+        noteCount = 0;
+        dragLineCount = 0;
+        pendingNoteRemovals.Clear();
+        pendingDragLineRemovals.Clear();
+    }
+}
@@ -18,10 +18,21 @@ public class ClassicHoldNoteRenderer : ClassicNoteRenderer
         InitializeHoldComponents();
     }
 
-    protected override void UpdateCollider()
+    private bool wasHolding;
+
+    protected override void CheckStateInputs()
+    {
+        base.CheckStateInputs();
+        if (HoldNote.IsHolding == wasHolding) return;
+        wasHolding = HoldNote.IsHolding;
+        IsStateDirty = true;
+    }
+
+    protected override float CalculateHitboxRadius()
     {
-        base.UpdateCollider();
-        if (HoldNote.IsHolding) Collider.radius *= 1.3333f;
+        var radius = base.CalculateHitboxRadius();
+        if (HoldNote.IsHolding) radius *= 1.3333f;
+        return radius;
     }
 
     protected virtual void InitializeHoldComponents()
@@ -62,6 +73,7 @@ public class ClassicHoldNoteRenderer : ClassicNoteRenderer
     public override void OnCollect()
     {
         base.OnCollect();
+        wasHolding = default;
         ProgressRing.Reset();
         Triangle.Reset();
         Triangle.gameObject.SetActive(false);
@@ -176,7 +188,7 @@ public class ClassicHoldNoteRenderer : ClassicNoteRenderer
     {
         base.UpdateColors();
         var mainModule = HoldFx.main;
-        mainModule.startColor = Fill.color;
+        mainModule.startColor = FillColor;
     }
 
     protected override void UpdateComponentOpacity()
@@ -13,6 +13,21 @@ public class ClassicNoteRenderer : NoteRenderer
     protected Color BaseRingColor;
     protected Color BaseFillColor;
 
+    // Colors with overrides applied, before opacity
+    protected Color RingColor;
+    protected Color FillColor;
+
+    // State-dependent work (colors, hitbox) only runs when set; see CheckStateInputs
+    protected bool IsStateDirty = true;
+    private int lastConfigOverrideVersion;
+    private int lastNoteOverrideVersion;
+
+    // Last values written to the components, so that unchanged values are not written again
+    private Color lastRingColor;
+    private Color lastFillColor;
+    private float lastColliderRadius;
+    private bool lastColliderEnabled;
+
     protected bool UseExperimentalAnimations { get; }
 
     public ClassicNoteRenderer(Note note) : base(note)
@@ -61,6 +76,12 @@ public class ClassicNoteRenderer : NoteRenderer
         {
             NoteId.SetModel(Note.Model);
         }
+
+        IsStateDirty = true;
+        lastRingColor = Ring.color;
+        lastFillColor = Fill.color;
+        lastColliderRadius = Collider.radius;
+        lastColliderEnabled = Collider.enabled;
     }
 
     public override void OnCollect()
@@ -70,28 +91,57 @@ public class ClassicNoteRenderer : NoteRenderer
         BaseTransformSize = default;
         BaseRingColor = default;
         BaseFillColor = default;
+        RingColor = default;
+        FillColor = default;
     }
 
     protected override void Render()
     {
         if (NoteId != null) NoteId.Visible = !(Game is PlayerGame playerGame) || !playerGame.HideInterface;
+        CheckStateInputs();
         UpdateComponentStates();
-        UpdateColors();
+        if (IsStateDirty) UpdateColors();
         UpdateTransformScale();
         UpdateFillScale();
         UpdateComponentOpacity();
-        UpdateCollider();
+        if (IsStateDirty) UpdateCollider();
+        UpdateColliderEnabled();
+        IsStateDirty = false;
     }
 
-    protected virtual void UpdateCollider()
+    /**
+     * Marks the state-dependent work dirty if any of its inputs has changed since the last frame. The storyboard bumps
+     * the override versions whenever it writes a color, size or hitbox override.
+     */
+    protected virtual void CheckStateInputs()
+    {
+        var configOverrideVersion = Game.Config.OverrideVersion;
+        var noteOverrideVersion = Note.Model.Override.Version;
+        if (configOverrideVersion == lastConfigOverrideVersion && noteOverrideVersion == lastNoteOverrideVersion) return;
+        lastConfigOverrideVersion = configOverrideVersion;
+        lastNoteOverrideVersion = noteOverrideVersion;
+        IsStateDirty = true;
+    }
+
+    protected virtual float CalculateHitboxRadius()
     {
-        Collider.enabled = Game.Time >= Note.Model.intro_time && Game.Time <= Note.Model.end_time + Note.MissThreshold;
-        
         var radius = Note.Game.Config.NoteHitboxSizes[Note.Type]; // Default hitbox 
         if (Note.Model.hitbox != double.MinValue) radius *= (float) Note.Model.hitbox;
         radius *= Note.Model.Override.SizeMultiplier; // Scales to storyboard-defined size
         radius *= Note.Model.Override.HitboxMultiplier;
-        Collider.radius = radius;
+        return radius;
+    }
+
+    protected virtual void UpdateCollider()
+    {
+        var radius = CalculateHitboxRadius();
+        if (radius != lastColliderRadius) Collider.radius = lastColliderRadius = radius;
+    }
+
+    protected virtual void UpdateColliderEnabled()
+    {
+        var enabled = Game.Time >= Note.Timings.IntroTimes[Note.Id] && Game.Time <= Note.Timings.EndTimes[Note.Id] + Note.MissThreshold;
+        if (enabled != lastColliderEnabled) Collider.enabled = lastColliderEnabled = enabled;
     }
 
     protected virtual void UpdateComponentStates()
@@ -127,12 +177,10 @@ public class ClassicNoteRenderer : NoteRenderer
 
     protected virtual void UpdateColors()
     {
-        Ring.color = Game.Config.GetRingColorOverride(Note.Model) != Color.clear
-            ? Game.Config.GetRingColorOverride(Note.Model)
-            : BaseRingColor;
-        Fill.color = Game.Config.GetFillColorOverride(Note.Model) != Color.clear
-            ? Game.Config.GetFillColorOverride(Note.Model)
-            : BaseFillColor;
+        var ringColorOverride = Game.Config.GetRingColorOverride(Note.Model);
+        RingColor = ringColorOverride != Color.clear ? ringColorOverride : BaseRingColor;
+        var fillColorOverride = Game.Config.GetFillColorOverride(Note.Model);
+        FillColor = fillColorOverride != Color.clear ? fillColorOverride : BaseFillColor;
     }
     
     protected virtual void UpdateTransformScale()
@@ -180,8 +228,10 @@ public class ClassicNoteRenderer : NoteRenderer
         EasedOpacity *= Game.Config.GlobalNoteOpacityMultiplier;
         EasedOpacity *= Note.Model.Override.OpacityMultiplier;
 
-        Ring.color = Ring.color.WithAlpha(EasedOpacity);
-        Fill.color = Fill.color.WithAlpha(EasedOpacity);
+        var ringColor = RingColor.WithAlpha(EasedOpacity);
+        if (ringColor != lastRingColor) Ring.color = lastRingColor = ringColor;
+        var fillColor = FillColor.WithAlpha(EasedOpacity);
+        if (fillColor != lastFillColor) Fill.color = lastFillColor = fillColor;
     }
 
     public override void OnClear(NoteGrade grade)
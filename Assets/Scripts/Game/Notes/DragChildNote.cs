@@ -12,37 +12,18 @@ public class DragChildNote : Note
             : throw new NotSupportedException();
     }
 
-    public override void OnTouch(Vector2 screenPos)
+    public override void OnTouch(Vector2 screenPos, float time)
     {
         // Do not handle touch event if touched too ahead of scanner
-        if (Model.start_time - Game.Time > 0.31f) return;
+        if (Model.start_time - time > 0.31f) return;
         // Do not handle touch event if in a later page, unless the timing is close (half a screen)
-        if (Model.page_index > Game.Chart.CurrentPageId && Model.start_time - Game.Time > Page.Duration / 2f) return;
-        base.OnTouch(screenPos);
+        if (Model.page_index > Game.Chart.CurrentPageId && Model.start_time - time > Page.Duration / 2f) return;
+        base.OnTouch(screenPos, time);
     }
 
-    public override NoteGrade CalculateGrade()
+    public override NoteGrade CalculateGrade(float time)
     {
-        var grade = NoteGrade.Miss;
-        var timeUntil = TimeUntilStart + JudgmentOffset;
-        if (timeUntil >= 0)
-        {
-            grade = NoteGrade.None;
-            if (timeUntil < 0.250f)
-            {
-                grade = NoteGrade.Perfect;
-            }
-        }
-        else
-        {
-            var timePassed = -timeUntil;
-            if (timePassed < 0.100f)
-            {
-                grade = NoteGrade.Perfect;
-            }
-        }
-
-        return grade;
+        return NoteJudging.GradeDragChild(TimeUntilJudgedStartAt(time));
     }
 
     public override async void Collect()
@@ -59,11 +40,6 @@ public class DragChildNote : Note
         base.Collect();
     }
         
-    public override bool IsAutoEnabled()
-    {
-        return base.IsAutoEnabled() || Game.State.Mods.Contains(Mod.AutoDrag);
-    }
-    
     public override void PlayHitSound()
     {
         if (Context.AudioManager.IsLoaded("HitSound"))
@@ -101,7 +101,9 @@ public class DragHeadNote : Note
                 }
             }
             
-            transform.localPosition = Vector3.Lerp(
+            // Kept in LocalPosition too, which the rotation is computed from once the head is cleared and stops being
+            // positioned by NoteUpdateScheduler
+            transform.localPosition = LocalPosition = Vector3.Lerp(
                 (hasFromNote && fromNote != this) ? fromNote.transform.localPosition : FromNoteModel.CalculatePosition(Game.Chart), 
                 hasToNote ? toNote.transform.localPosition : ToNoteModel.CalculatePosition(Game.Chart),
                 (Game.Time - FromNoteModel.start_time) / (ToNoteModel.start_time - FromNoteModel.start_time));
@@ -111,7 +113,8 @@ public class DragHeadNote : Note
             {
                 if (ToNoteModel == EndNoteModel) // Last note
                 {
-                    transform.localPosition = hasToNote ? toNote.transform.localPosition : ToNoteModel.CalculatePosition(Game.Chart);
+                    transform.localPosition = LocalPosition =
+                        hasToNote ? toNote.transform.localPosition : ToNoteModel.CalculatePosition(Game.Chart);
                 }
                 else
                 {
@@ -162,17 +165,17 @@ public class DragHeadNote : Note
         }
     }
 
-    public override void OnTouch(Vector2 screenPos)
+    public override void OnTouch(Vector2 screenPos, float time)
     {
         if (!IsCDrag)
         {
             // Do not handle touch event if touched too ahead of scanner
-            if (Model.start_time - Game.Time > 0.31f) return;
+            if (Model.start_time - time > 0.31f) return;
             // Do not handle touch event if in a later page, unless the timing is close (half a screen) TODO: Fix inaccurate algorithm
             if (Model.page_index > Game.Chart.CurrentPageId &&
-                Model.start_time - Game.Time > Page.Duration / 2f) return;
+                Model.start_time - time > Page.Duration / 2f) return;
         }
-        base.OnTouch(screenPos);
+        base.OnTouch(screenPos, time);
     }
 
     public override async void Collect()
@@ -210,38 +213,15 @@ public class DragHeadNote : Note
         base.Collect();
     }
 
-    public override NoteGrade CalculateGrade()
+    public override NoteGrade CalculateGrade(float time)
     {
         if (IsCDrag)
         {
-            return base.CalculateGrade();
+            return base.CalculateGrade(time);
         }
-        var grade = NoteGrade.Miss;
-        var timeUntilStart = TimeUntilStart + JudgmentOffset;
-        if (timeUntilStart >= 0)
-        {
-            grade = NoteGrade.None;
-            if (timeUntilStart < 0.500f)
-            {
-                grade = NoteGrade.Perfect;
-            }
-        }
-        else
-        {
-            var timePassed = -timeUntilStart;
-            if (timePassed < 0.200f)
-            {
-                grade = NoteGrade.Perfect;
-            }
-        }
-        return grade;
+        return NoteJudging.GradeDragHead(TimeUntilJudgedStartAt(time));
     }
 
-    public override bool IsAutoEnabled()
-    {
-        return base.IsAutoEnabled() || Game.State.Mods.Contains(Mod.AutoDrag);
-    }
-    
     public override void PlayHitSound()
     {
         if (Context.AudioManager.IsLoaded("HitSound"))
@@ -5,12 +5,19 @@ public class DragLineElement : MonoBehaviour
 {
     private static readonly int MaterialEnd = Shader.PropertyToID("_End");
     private static readonly int MaterialStart = Shader.PropertyToID("_Start");
+    private static readonly int MaterialMainTexST = Shader.PropertyToID("_MainTex_ST");
+
+    // Shared by all drag lines; the per-line values are passed through a property block instead of writing to
+    // spriteRenderer.material, which would instantiate a material for every line
+    private static MaterialPropertyBlock propertyBlock;
     
     private Game Game { get; set; }
     
     private SpriteRenderer spriteRenderer;
     
     public bool IsCollected { get; private set; }
+
+    public int SchedulerIndex { get; set; } = -1; // Slot in NoteUpdateScheduler
     public ChartModel.Note FromNoteModel { get; private set; }
     public ChartModel.Note ToNoteModel { get; private set; }
 
@@ -24,9 +31,14 @@ public class DragLineElement : MonoBehaviour
 
     private float length;
 
+    private float materialStart;
+    private float materialEnd;
+    private bool isPropertyBlockDirty;
+
     private void Awake()
     {
         spriteRenderer = GetComponent<SpriteRenderer>();
+        if (propertyBlock == null) propertyBlock = new MaterialPropertyBlock();
     }
 
     public void Initialize(Game game)
@@ -45,11 +57,13 @@ public class DragLineElement : MonoBehaviour
         
         FromNoteModel = fromNoteModel;
         ToNoteModel = toNoteModel;
-        spriteRenderer.material.SetFloat(MaterialEnd, 0.0f);
-        spriteRenderer.material.SetFloat(MaterialStart, 0.0f);
+        materialEnd = 0.0f;
+        materialStart = 0.0f;
         UpdateTransform();
+        isPropertyBlockDirty = true;
+        ApplyPropertyBlock();
         spriteRenderer.sortingOrder = fromNoteModel.id;
-        Game.onGameUpdate.AddListener(OnGameUpdate);
+        Game.NoteUpdateScheduler.Add(this);
     }
 
     private void UpdateTransform()
@@ -92,15 +106,21 @@ public class DragLineElement : MonoBehaviour
         
         var transform = this.transform;
         transform.localPosition = fromNotePosition;
-        length = Vector3.Distance(
+        var newLength = Vector3.Distance(
             fromNotePosition, 
             toNotePosition
         );
-        spriteRenderer.material.mainTextureScale = new Vector2(1.0f, length / 0.16f);
+        if (newLength != length)
+        {
+            length = newLength;
+            isPropertyBlockDirty = true;
+        }
         transform.localEulerAngles = hasFromNote ? fromNote.transform.localEulerAngles : FromNoteModel.rotation;
         transform.localScale = new Vector3(1.0f, length / 0.16f);
     }
 
+    public void InvokeGameUpdate() => OnGameUpdate(Game);
+
     private void OnGameUpdate(Game _)
     {
         UpdateTransform();
@@ -137,23 +157,43 @@ public class DragLineElement : MonoBehaviour
                      (FromNoteModel.nextdraglinestoptime - FromNoteModel.nextdraglinestarttime);
         outroRatio = (time - FromNoteModel.start_time) / (ToNoteModel.start_time - FromNoteModel.start_time);
 
+        float end;
         if (introRatio > 0 && introRatio < 1)
         {
-            spriteRenderer.material.SetFloat(MaterialEnd, 1.0f - introRatio);
+            end = 1.0f - introRatio;
         }
         else if (introRatio <= 0)
         {
-            spriteRenderer.material.SetFloat(MaterialEnd, 1.0f);
+            end = 1.0f;
         }
         else
         {
-            spriteRenderer.material.SetFloat(MaterialEnd, 0.0f);
+            end = 0.0f;
+        }
+        if (end != materialEnd)
+        {
+            materialEnd = end;
+            isPropertyBlockDirty = true;
         }
 
-        if (outroRatio > 0 && outroRatio < 1)
+        if (outroRatio > 0 && outroRatio < 1 && outroRatio != materialStart)
         {
-            spriteRenderer.material.SetFloat(MaterialStart, outroRatio);
+            materialStart = outroRatio;
+            isPropertyBlockDirty = true;
         }
+
+        ApplyPropertyBlock();
+    }
+
+    private void ApplyPropertyBlock()
+    {
+        if (!isPropertyBlockDirty) return;
+        isPropertyBlockDirty = false;
+        spriteRenderer.GetPropertyBlock(propertyBlock);
+        propertyBlock.SetFloat(MaterialStart, materialStart);
+        propertyBlock.SetFloat(MaterialEnd, materialEnd);
+        propertyBlock.SetVector(MaterialMainTexST, new Vector4(1.0f, length / 0.16f, 0, 0));
+        spriteRenderer.SetPropertyBlock(propertyBlock);
     }
 
     public void Collect()
@@ -162,7 +202,7 @@ public class DragLineElement : MonoBehaviour
         IsCollected = true;
         
         Game.ObjectPool.CollectDragLine(this);
-        Game.onGameUpdate.RemoveListener(OnGameUpdate);
+        Game.NoteUpdateScheduler.Remove(this);
         FromNoteModel = default;
         ToNoteModel = default;
         hasFromNote = default;
@@ -172,5 +212,8 @@ public class DragLineElement : MonoBehaviour
         introRatio = default;
         outroRatio = default;
         length = default;
+        materialStart = default;
+        materialEnd = default;
+        isPropertyBlockDirty = default;
     }
 }
\ No newline at end of file
@@ -16,21 +16,21 @@ public class FlickNote : Note
             : throw new NotSupportedException();
     }
 
-    public override void OnTouch(Vector2 screenPos)
+    public override void OnTouch(Vector2 screenPos, float time)
     {
         // This method should never be invoked!
         throw new InvalidOperationException();
     }
 
-    public void StartFlicking(Vector2 screenPos)
+    public void StartFlicking(Vector2 screenPos, float time)
     {
         if (!Game.State.IsPlaying || IsFlicking) return;
         IsFlicking = true;
-        FlickingStartTime = Game.Time;
+        FlickingStartTime = time;
         FlickingStartPosition = screenPos;
     }
 
-    public bool UpdateFingerPosition(Vector2 screenPos)
+    public bool UpdateFingerPosition(Vector2 screenPos, float time)
     {
         if (!Game.State.IsPlaying) return false;
         if (IsCleared) return true;
@@ -38,7 +38,7 @@ public class FlickNote : Note
         // TODO: Consider rotation
         if (Math.Abs(swipeVector.x) > Game.camera.orthographicSize * 0.01f)
         {
-            TryClear();
+            TryClear(time);
             return true;
         }
         return false;
@@ -55,47 +55,9 @@ public class FlickNote : Note
         base.Collect();
     }
 
-    public override NoteGrade CalculateGrade()
+    public override NoteGrade CalculateGrade(float time)
     {
-        if (ShouldMiss()) return NoteGrade.Miss;
-
-        var grade = NoteGrade.None;
-        var timeUntil = TimeUntilStart + JudgmentOffset;
-
-        if (Game.State.Mode == GameMode.Practice)
-        {
-            if (timeUntil >= 0)
-            {
-                if (timeUntil < 0.800f) grade = NoteGrade.Great;
-                if (timeUntil <= 0.200f) grade = NoteGrade.Perfect;
-            }
-            else
-            {
-                var timePassed = -timeUntil;
-                if (timePassed < 0.300f) grade = NoteGrade.Great;
-                if (timePassed <= 0.100f) grade = NoteGrade.Perfect;
-            }
-        }
-        else
-        {
-            if (timeUntil >= 0)
-            {
-                if (timeUntil < 0.150f) grade = NoteGrade.Great; // 0.400
-                if (timeUntil <= 0.060f) grade = NoteGrade.Perfect; // 0.120
-            }
-            else
-            {
-                var timePassed = -timeUntil;
-                if (timePassed < 0.150f) grade = NoteGrade.Great;
-                if (timePassed <= 0.060f) grade = NoteGrade.Perfect;
-            }
-        }
-        return grade;
+        if (ShouldMiss(time)) return NoteGrade.Miss;
+        return NoteJudging.GradeFlick(Game.State.Mode, TimeUntilJudgedStartAt(time));
     }
-
-    public override bool IsAutoEnabled()
-    {
-        return base.IsAutoEnabled() || Game.State.Mods.Contains(Mod.AutoFlick);
-    }
-    
 }
\ No newline at end of file
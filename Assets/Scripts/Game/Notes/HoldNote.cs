@@ -37,14 +37,7 @@ public class HoldNote : Note
         base.OnGameUpdate(_);
         if (IsHolding)
         {
-            if (Game.Time >= Model.start_time + JudgmentOffset)
-            {
-                HeldDuration = Game.Time - Mathf.Max(Model.start_time + JudgmentOffset, HoldingStartTime);
-            }
-            else
-            {
-                HeldDuration = 0;
-            }
+            HeldDuration = NoteJudging.GetHeldDuration(Game.Time, HoldingStartTime, Model.start_time + JudgmentOffset);
             HoldProgress = (Game.Time - (Model.start_time + JudgmentOffset)) / Model.Duration;
             
             if (!playedHitSoundAtBegin && HoldProgress >= 0 && Context.Player.Settings.HoldHitSoundTiming.Let(it => it == HoldHitSoundTiming.Begin || it == HoldHitSoundTiming.Both))
@@ -54,10 +47,11 @@ public class HoldNote : Note
             }
 
             // Already completed?
-            if (Game.Time >= Model.end_time + JudgmentOffset)
+            if (NoteJudging.IsHoldCompleted(Game.Time, Model.end_time + JudgmentOffset))
             {
                 HoldingFingers.Clear();
-                if (Game.Time > Model.start_time + JudgmentOffset && Game.State.IsPlaying)
+                Game.inputController.UpdateTouchable(this);
+                if (NoteJudging.ShouldJudgeHold(Game.Time, Model.start_time + JudgmentOffset) && Game.State.IsPlaying)
                 {
                     Clear(IsAutoEnabled() ? NoteGrade.Perfect : CalculateGrade());
                 }
@@ -69,17 +63,20 @@ public class HoldNote : Note
         }
     }
 
-    public override bool ShouldMiss()
+    public override bool ShouldMiss(float time)
     {
-        return !IsHolding && base.ShouldMiss();
+        return NoteJudging.ShouldMiss(TimeUntilJudgedStartAt(time), MissThreshold, IsHolding);
     }
     
-    public override void OnTouch(Vector2 screenPos)
+    public override void OnTouch(Vector2 screenPos, float time)
     {
         // Do nothing
     }
 
-    public void UpdateFinger(int finger, bool isHolding)
+    /**
+     * time is the chart time at which the finger pressed or released the note.
+     */
+    public void UpdateFinger(int finger, bool isHolding, float time)
     {
         var previouslyHolding = IsHolding;
         
@@ -88,7 +85,7 @@ public class HoldNote : Note
             HoldingFingers.Add(finger);
             if (!previouslyHolding)
             {
-                HoldingStartTime = Game.Time;
+                HoldingStartTime = time;
             }
         }
         else
@@ -96,51 +93,29 @@ public class HoldNote : Note
             HoldingFingers.Remove(finger);
         }
 
-        if (HoldingFingers.Count == 0 && Game.Time > Model.start_time + JudgmentOffset)
-        {
-            if (Game.Time > Model.start_time + JudgmentOffset && Game.State.IsPlaying)
-            {
-                Clear(IsAutoEnabled() ? NoteGrade.Perfect : CalculateGrade());
-            }
-        }
-    }
-
-    public override NoteGrade CalculateGrade()
-    {
-        var grade = NoteGrade.Miss;
-        var rankedGrade = NoteGrade.Miss;
-        // print($"HeldDuration: {HeldDuration}, ModelDuration: {Model.Duration}, HoldingStartTime: {HoldingStartTime}, ModelStartTime: {Model.start_time}");
-        if (HeldDuration > Model.Duration - 0.05f) grade = NoteGrade.Perfect;
-        else if (HeldDuration > Model.Duration * 0.7f) grade = NoteGrade.Great;
-        else if (HeldDuration > Model.Duration * 0.5f) grade = NoteGrade.Good;
-        else if (HeldDuration > Model.Duration * 0.3f) grade = NoteGrade.Bad;
+        if (IsHolding != previouslyHolding) Game.inputController.UpdateTouchable(this);
 
-        if (Game.State.Mode != GameMode.Practice)
+        if (HoldingFingers.Count == 0 && NoteJudging.ShouldJudgeHold(time, Model.start_time + JudgmentOffset))
         {
-            if (HoldingStartTime != float.MaxValue && Mathf.Max(HoldingStartTime, Model.start_time + JudgmentOffset) > Model.start_time + JudgmentOffset)
+            if (previouslyHolding)
             {
-                var lateBy = HoldingStartTime - (Model.start_time + JudgmentOffset);
-                if (lateBy < 0.200f) rankedGrade = NoteGrade.Bad;
-                if (lateBy < 0.150f) rankedGrade = NoteGrade.Good;
-                if (lateBy < 0.070f) rankedGrade = NoteGrade.Great;
-                if (lateBy <= 0.040f) rankedGrade = NoteGrade.Perfect;
-                if (rankedGrade == NoteGrade.Great) GreatGradeWeight = 1.0f - (lateBy - 0.040f) / (0.070f - 0.040f);
+                // Count the held time up to the release rather than up to the last frame
+                HeldDuration = Mathf.Max(HeldDuration,
+                    NoteJudging.GetHeldDuration(time, HoldingStartTime, Model.start_time + JudgmentOffset));
             }
-            else
+            if (Game.State.IsPlaying)
             {
-                rankedGrade = grade;
-                if (rankedGrade == NoteGrade.Great) GreatGradeWeight = 1.0f - (HeldDuration - Model.Duration * 0.70f) /
-                                       (Model.Duration - 0.050f - Model.Duration * 0.70f);
+                Clear(IsAutoEnabled() ? NoteGrade.Perfect : CalculateGrade(time), time);
             }
         }
-
-        if (Game.State.Mode != GameMode.Practice && rankedGrade < grade)
-            return rankedGrade; // Return the "worse" ranking (Note miss < bad < good < great < perfect)
-        return grade;
     }
 
-    public override bool IsAutoEnabled()
+    public override NoteGrade CalculateGrade(float time)
     {
-        return base.IsAutoEnabled() || Game.State.Mods.Contains(Mod.AutoHold);
+        var greatGradeWeight = GreatGradeWeight;
+        var grade = NoteJudging.GradeHold(Game.State.Mode, Model.Duration, HeldDuration, HoldingStartTime,
+            Model.start_time + JudgmentOffset, ref greatGradeWeight);
+        GreatGradeWeight = greatGradeWeight;
+        return grade;
     }
 }
\ No newline at end of file
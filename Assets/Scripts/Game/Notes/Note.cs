@@ -1,5 +1,4 @@
 ﻿using System;
-
 using Cysharp.Threading.Tasks;
 using UnityEngine;
 
@@ -10,15 +9,22 @@ public abstract class Note : MonoBehaviour
     public bool IsInitialized { get; private set; }
     
     public bool IsCollected { get; private set; }
+
+    public int SchedulerIndex { get; set; } = -1; // Slot in NoteUpdateScheduler
     
     public Game Game { get; private set; }
     public ChartModel.Note Model { get; private set; }
+    public int Id { get; private set; }
     public ChartModel.Note NextNoteModel { get; private set; }
 
+    // Local position last computed by NoteUpdateScheduler (which also writes it to the transform)
+    public Vector3 LocalPosition { get; protected set; }
+
     private bool hasNextNote;
     private Note nextNote;
     
     public ChartModel Chart { get; private set; }
+    public NoteTimingTable Timings { get; private set; }
     public ChartModel.Page Page { get; private set; }
     public NoteType Type { get; private set; }
     
@@ -26,15 +32,21 @@ public abstract class Note : MonoBehaviour
     
     public bool IsCleared { get; private set; }
 
+    // Emerged and not cleared, as last reported to InputController
+    public bool IsTouchable { get; private set; }
+
     // For ranked mode: weighted difference between the current timing and the perfect timing
     public float GreatGradeWeight { get; protected set; }
     
     public float JudgmentOffset { get; protected set; }
     
-    public bool HasEmerged => Game.Time >= Model.intro_time;
+    public bool HasEmerged => Game.Time >= Timings.IntroTimes[Id];
     
-    public float TimeUntilStart => Model.start_time - Game.Time;
-    public float TimeUntilEnd => Model.end_time - Game.Time;
+    public float TimeUntilStart => Timings.StartTimes[Id] - Game.Time;
+    public float TimeUntilEnd => Timings.EndTimes[Id] - Game.Time;
+
+    // Time until the judged start time (i.e. with judgment offset) at the given chart time, negative if late
+    public float TimeUntilJudgedStartAt(float time) => Timings.StartTimes[Id] + JudgmentOffset - time;
 
     public void Initialize(Game game)
     {
@@ -49,21 +61,22 @@ public abstract class Note : MonoBehaviour
         IsCollected = false;
     
         Chart = Game.Chart.Model;
+        Timings = Game.Chart.NoteTimings;
+        Id = noteId;
         Model = Game.Chart.Model.note_map[noteId];
-        if (Model.next_id > 0 && Chart.note_map.ContainsKey(Model.next_id))
+        if (Model.next_id > 0 && Chart.HasNote(Model.next_id))
         {
             NextNoteModel = Chart.note_map[Model.next_id];
         }
 
-        Page = Chart.page_list[Model.page_index];
-        Type = (NoteType) Model.type;
+        Page = Chart.page_list[Timings.PageIndices[noteId]];
+        Type = Timings.Types[noteId];
         
         Renderer.OnNoteLoaded();
         MissThreshold = Type.GetDefaultMissThreshold();
         JudgmentOffset = Context.Player.Settings.JudgmentOffset;
         
-        Game.onGameUpdate.AddListener(OnGameUpdate);
-        Game.onGameLateUpdate.AddListener(OnGameLateUpdate);
+        Game.NoteUpdateScheduler.Add(this);
     }
 
     public async void AwaitAndCollect()
@@ -79,28 +92,37 @@ public abstract class Note : MonoBehaviour
         
         Renderer.OnCollect();
         Game.ObjectPool.CollectNote(this);
-        Game.onGameUpdate.RemoveListener(OnGameUpdate);
-        Game.onGameLateUpdate.RemoveListener(OnGameLateUpdate);
+        Game.NoteUpdateScheduler.Remove(this);
         Model = default;
         NextNoteModel = default;
         hasNextNote = default;
         nextNote = default;
         Chart = default;
+        Timings = default;
         Page = default;
         MissThreshold = default;
         IsCleared = default;
+        IsTouchable = default;
+        LocalPosition = default;
         GreatGradeWeight = default;
         JudgmentOffset = default;
     }
 
-    public virtual void Clear(NoteGrade grade)
+    public void Clear(NoteGrade grade) => Clear(grade, Game.Time);
+
+    /**
+     * Judges the note as if it was cleared at the given chart time, e.g. the time of the input that cleared it.
+     */
+    public virtual void Clear(NoteGrade grade, float time)
     {
         if (IsCleared) return;
 
         IsCleared = true;
+        UpdateTouchable();
         Renderer.OnClear(grade);
-        Game.State.Judge(this, grade, -TimeUntilEnd, GreatGradeWeight);
-        Game.onNoteJudged.Invoke(Game, this, new JudgeData(grade, -TimeUntilEnd, GreatGradeWeight));
+        var error = time - Timings.EndTimes[Id];
+        Game.State.Judge(this, grade, error, GreatGradeWeight);
+        Game.onNoteJudged.Invoke(Game, this, new JudgeData(grade, error, GreatGradeWeight));
 
         // Hit sound
         if (grade != NoteGrade.Miss && (!(this is HoldNote) || Context.Player.Settings.HoldHitSoundTiming.Let(it => it == HoldHitSoundTiming.End || it == HoldHitSoundTiming.Both)))
@@ -121,7 +143,15 @@ public abstract class Note : MonoBehaviour
         Context.Haptic(HapticTypes.LightImpact, false);
     }
 
-    protected virtual void OnGameUpdate(Game _)
+    public void InvokeGameUpdate() => OnGameUpdate(Game);
+
+    public void InvokeGameLateUpdate() => OnGameLateUpdate(Game);
+
+    /**
+     * First step of the game update, run by NoteUpdateScheduler for all notes before any OnGameUpdate. Returns false if
+     * the note has been cleared and should stay where it is.
+     */
+    public virtual bool UpdateLocalPosition()
     {
         // Reset cleared status in player mode
         if (Game is PlayerGame && IsCleared)
@@ -132,24 +162,25 @@ public abstract class Note : MonoBehaviour
             }
         }
 
+        if (IsCleared) return false;
+        LocalPosition = Model.CalculatePosition(Game.Chart);
+        return true;
+    }
+
+    protected virtual void OnGameUpdate(Game _)
+    {
         if (!IsCleared)
         {
-            // Update position
-            gameObject.transform.localPosition = Model.CalculatePosition(Game.Chart);
-            
             // Autoplay
-            if (IsAutoEnabled())
+            if (NoteJudging.ShouldAutoplay(Game.State, Type, TimeUntilStart))
             {
-                if (TimeUntilStart < 0)
+                if (this is HoldNote)
+                {
+                    ((HoldNote) this).UpdateFinger(0, true, Game.Time);
+                }
+                else
                 {
-                    if (this is HoldNote)
-                    {
-                        ((HoldNote) this).UpdateFinger(0, true);
-                    }
-                    else
-                    {
-                        Clear(NoteGrade.Perfect);
-                    }
+                    Clear(NoteGrade.Perfect);
                 }
             }
 
@@ -160,11 +191,29 @@ public abstract class Note : MonoBehaviour
             }
         }
 
+        UpdateTouchable();
         Renderer.OnLateUpdate();
     }
 
+    protected void UpdateTouchable()
+    {
+        var isTouchable = !IsCleared && HasEmerged;
+        if (isTouchable == IsTouchable) return;
+        IsTouchable = isTouchable;
+        Game.inputController.UpdateTouchable(this);
+    }
+
     protected virtual void OnGameLateUpdate(Game _)
     {
+    }
+
+    /**
+     * Computes the local euler angles from the direction to the next note and the storyboard overrides, before
+     * OnGameLateUpdate. Run by NoteUpdateScheduler, which writes the result to the transform.
+     */
+    public virtual Vector3 UpdateRotation()
+    {
+        Vector3? nextPosition = null;
         if (NextNoteModel != null)
         {
             if (Game.SpawnedNotes.ContainsKey(NextNoteModel.id))
@@ -184,33 +233,17 @@ public abstract class Note : MonoBehaviour
                 }
             }
 
-            var position = transform.localPosition;
-            var nextPosition = hasNextNote ? nextNote.transform.localPosition : NextNoteModel.position;
-
-            if (position == nextPosition)
-                Model.rotation = Vector3.zero;
-            else if (Math.Abs(position.y - nextPosition.y) < 0.000001)
-                Model.rotation = new Vector3(0, 0, position.x > nextPosition.x ? 90 : -90);
-            else if (Math.Abs(position.x - nextPosition.x) < 0.000001)
-                Model.rotation = new Vector3(0, 0, position.y > nextPosition.y ? -180 : 0);
-            else
-                Model.rotation = new Vector3(0, 0, -(
-                    Mathf.Atan((nextPosition.x - position.x) /
-                               (nextPosition.y - position.y)) / Mathf.PI * 180f +
-                    (nextPosition.y > position.y ? 0 : 180)));
+            nextPosition = hasNextNote ? nextNote.LocalPosition : NextNoteModel.position;
         }
 
-        var rotation = Model.rotation;
-        if (Model.Override.RotX != null) rotation.x = Model.Override.RotX.Value;
-        if (Model.Override.RotY != null) rotation.y = Model.Override.RotY.Value;
-        if (Model.Override.RotZ != null) rotation.z = Model.Override.RotZ.Value;
-
-        gameObject.transform.localEulerAngles = Model.rotation = rotation;
+        return Model.UpdateRotation(LocalPosition, nextPosition);
     }
 
-    public virtual bool ShouldMiss()
+    public bool ShouldMiss() => ShouldMiss(Game.Time);
+
+    public virtual bool ShouldMiss(float time)
     {
-        return Game.Time - (Model.start_time + JudgmentOffset) > MissThreshold;
+        return NoteJudging.ShouldMiss(TimeUntilJudgedStartAt(time), MissThreshold);
     }
 
     public void OnDestroy()
@@ -224,64 +257,30 @@ public abstract class Note : MonoBehaviour
         Renderer?.Dispose();
     }
 
-    public virtual void OnTouch(Vector2 screenPos)
+    /**
+     * time is the chart time at which the touch happened, which may be earlier than Game.Time.
+     */
+    public virtual void OnTouch(Vector2 screenPos, float time)
     {
         if (!Game.IsLoaded || !Game.State.IsPlaying) return;
-        TryClear();
+        TryClear(time);
     }
 
-    public virtual void TryClear()
+    public virtual void TryClear(float time)
     {
-        if (IsAutoEnabled()) Clear(NoteGrade.Perfect);
-        if (ShouldMiss()) Clear(NoteGrade.Miss);
-        var grade = CalculateGrade();
-        if (grade != NoteGrade.None) Clear(grade);
+        if (IsAutoEnabled()) Clear(NoteGrade.Perfect, time);
+        if (ShouldMiss(time)) Clear(NoteGrade.Miss, time);
+        var grade = CalculateGrade(time);
+        if (grade != NoteGrade.None) Clear(grade, time);
     }
 
-    public virtual NoteGrade CalculateGrade()
-    {
-        var grade = NoteGrade.None;
-        var timeUntil = TimeUntilStart + JudgmentOffset;
-
-        if (Game.State.Mode == GameMode.Practice)
-        {
-            if (timeUntil >= 0)
-            {
-                if (timeUntil < 0.800f) grade = NoteGrade.Bad;
-                if (timeUntil < 0.400f) grade = NoteGrade.Good;
-                if (timeUntil < 0.200f) grade = NoteGrade.Great;
-                if (timeUntil < 0.070f) grade = NoteGrade.Perfect;
-            }
-            else
-            {
-                var timePassed = -timeUntil;
-                if (timePassed < 0.300f) grade = NoteGrade.Bad;
-                if (timePassed < 0.200f) grade = NoteGrade.Good;
-                if (timePassed < 0.150f) grade = NoteGrade.Great;
-                if (timePassed < 0.070f) grade = NoteGrade.Perfect;
-            }
-        }
-        else
-        {
-            if (timeUntil >= 0)
-            {
-                if (timeUntil < 0.400f) grade = NoteGrade.Bad;
-                if (timeUntil < 0.200f) grade = NoteGrade.Good;
-                if (timeUntil < 0.070f) grade = NoteGrade.Great;
-                if (timeUntil <= 0.040f) grade = NoteGrade.Perfect;
-                if (grade == NoteGrade.Great) GreatGradeWeight = 1.0f - (timeUntil - 0.040f) / (0.070f - 0.040f);
-            }
-            else
-            {
-                var timePassed = -timeUntil;
-                if (timePassed < 0.200f) grade = NoteGrade.Bad;
-                if (timePassed < 0.150f) grade = NoteGrade.Good;
-                if (timePassed < 0.070f) grade = NoteGrade.Great;
-                if (timePassed <= 0.040f) grade = NoteGrade.Perfect;
-                if (grade == NoteGrade.Great) GreatGradeWeight = 1.0f - (timePassed - 0.040f) / (0.070f - 0.040f);
-            }
-        }
+    public NoteGrade CalculateGrade() => CalculateGrade(Game.Time);
 
+    public virtual NoteGrade CalculateGrade(float time)
+    {
+        var greatGradeWeight = GreatGradeWeight;
+        var grade = NoteJudging.GradeTap(Game.State.Mode, TimeUntilJudgedStartAt(time), ref greatGradeWeight);
+        GreatGradeWeight = greatGradeWeight;
         return grade;
     }
 
@@ -290,10 +289,7 @@ public abstract class Note : MonoBehaviour
         return Renderer.DoesCollide(pos);
     }
 
-    public virtual bool IsAutoEnabled()
-    {
-        return Game.State.Mods.Contains(Mod.Auto);
-    }
+    public bool IsAutoEnabled() => NoteJudging.IsAutoEnabled(Game.State, Type);
 
     protected abstract NoteRenderer CreateRenderer();
 }
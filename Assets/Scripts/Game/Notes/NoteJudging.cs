@@ -0,0 +1,207 @@
+using UnityEngine;
+
+/**
+ * Timing windows of each note type, free of any scene state so that they can be shared by the note behaviours and
+ * HeadlessGameSimulator. timeUntil is the time until the note's start time (plus judgment offset), negative if late.
+ * greatGradeWeight is only assigned when the result is (or, for holds, may become) a Great.
+ */
+public static class NoteJudging
+{
+    public static bool IsAutoEnabled(GameState state, NoteType type)
+    {
+        if (state.HasAutoMod) return true;
+        switch (type)
+        {
+            case NoteType.Hold:
+            case NoteType.LongHold:
+                return state.Mods.Contains(Mod.AutoHold);
+            case NoteType.Flick:
+                return state.Mods.Contains(Mod.AutoFlick);
+            case NoteType.DragHead:
+            case NoteType.DragChild:
+            case NoteType.CDragHead:
+            case NoteType.CDragChild:
+                return state.Mods.Contains(Mod.AutoDrag);
+            default:
+                return false;
+        }
+    }
+
+    /**
+     * Whether an autoplayed note is due; timeUntilStart is without judgment offset. Holds are pressed, other notes
+     * cleared as Perfect.
+     */
+    public static bool ShouldAutoplay(GameState state, NoteType type, float timeUntilStart)
+    {
+        return timeUntilStart < 0 && IsAutoEnabled(state, type);
+    }
+
+    // A hold note that is being held is never missed
+    public static bool ShouldMiss(float timeUntil, float missThreshold, bool isHolding = false)
+    {
+        return !isHolding && -timeUntil > missThreshold;
+    }
+
+    /**
+     * How long a hold note has been held at the given time, counted from its judged start time at the earliest.
+     */
+    public static float GetHeldDuration(float time, float holdingStartTime, float judgedStartTime)
+    {
+        return time >= judgedStartTime ? time - Mathf.Max(judgedStartTime, holdingStartTime) : 0;
+    }
+
+    /**
+     * A hold note is judged once it is released (or completed) after its judged start time; releasing it earlier
+     * leaves it to be missed.
+     */
+    public static bool ShouldJudgeHold(float time, float judgedStartTime) => time > judgedStartTime;
+
+    public static bool IsHoldCompleted(float time, float judgedEndTime) => time >= judgedEndTime;
+
+    public static NoteGrade GradeTap(GameMode mode, float timeUntil, ref float greatGradeWeight)
+    {
+        var grade = NoteGrade.None;
+
+        if (mode == GameMode.Practice)
+        {
+            if (timeUntil >= 0)
+            {
+                if (timeUntil < 0.800f) grade = NoteGrade.Bad;
+                if (timeUntil < 0.400f) grade = NoteGrade.Good;
+                if (timeUntil < 0.200f) grade = NoteGrade.Great;
+                if (timeUntil < 0.070f) grade = NoteGrade.Perfect;
+            }
+            else
+            {
+                var timePassed = -timeUntil;
+                if (timePassed < 0.300f) grade = NoteGrade.Bad;
+                if (timePassed < 0.200f) grade = NoteGrade.Good;
+                if (timePassed < 0.150f) grade = NoteGrade.Great;
+                if (timePassed < 0.070f) grade = NoteGrade.Perfect;
+            }
+        }
+        else
+        {
+            if (timeUntil >= 0)
+            {
+                if (timeUntil < 0.400f) grade = NoteGrade.Bad;
+                if (timeUntil < 0.200f) grade = NoteGrade.Good;
+                if (timeUntil < 0.070f) grade = NoteGrade.Great;
+                if (timeUntil <= 0.040f) grade = NoteGrade.Perfect;
+                if (grade == NoteGrade.Great) greatGradeWeight = 1.0f - (timeUntil - 0.040f) / (0.070f - 0.040f);
+            }
+            else
+            {
+                var timePassed = -timeUntil;
+                if (timePassed < 0.200f) grade = NoteGrade.Bad;
+                if (timePassed < 0.150f) grade = NoteGrade.Good;
+                if (timePassed < 0.070f) grade = NoteGrade.Great;
+                if (timePassed <= 0.040f) grade = NoteGrade.Perfect;
+                if (grade == NoteGrade.Great) greatGradeWeight = 1.0f - (timePassed - 0.040f) / (0.070f - 0.040f);
+            }
+        }
+
+        return grade;
+    }
+
+    public static NoteGrade GradeFlick(GameMode mode, float timeUntil)
+    {
+        var grade = NoteGrade.None;
+
+        if (mode == GameMode.Practice)
+        {
+            if (timeUntil >= 0)
+            {
+                if (timeUntil < 0.800f) grade = NoteGrade.Great;
+                if (timeUntil <= 0.200f) grade = NoteGrade.Perfect;
+            }
+            else
+            {
+                var timePassed = -timeUntil;
+                if (timePassed < 0.300f) grade = NoteGrade.Great;
+                if (timePassed <= 0.100f) grade = NoteGrade.Perfect;
+            }
+        }
+        else
+        {
+            if (timeUntil >= 0)
+            {
+                if (timeUntil < 0.150f) grade = NoteGrade.Great; // 0.400
+                if (timeUntil <= 0.060f) grade = NoteGrade.Perfect; // 0.120
+            }
+            else
+            {
+                var timePassed = -timeUntil;
+                if (timePassed < 0.150f) grade = NoteGrade.Great;
+                if (timePassed <= 0.060f) grade = NoteGrade.Perfect;
+            }
+        }
+        return grade;
+    }
+
+    public static NoteGrade GradeDragChild(float timeUntil) => GradeDrag(timeUntil, 0.250f, 0.100f);
+
+    // Classic (non-C) drag heads only; C-drag heads are graded like taps
+    public static NoteGrade GradeDragHead(float timeUntil) => GradeDrag(timeUntil, 0.500f, 0.200f);
+
+    private static NoteGrade GradeDrag(float timeUntil, float earlyWindow, float lateWindow)
+    {
+        var grade = NoteGrade.Miss;
+        if (timeUntil >= 0)
+        {
+            grade = NoteGrade.None;
+            if (timeUntil < earlyWindow)
+            {
+                grade = NoteGrade.Perfect;
+            }
+        }
+        else
+        {
+            var timePassed = -timeUntil;
+            if (timePassed < lateWindow)
+            {
+                grade = NoteGrade.Perfect;
+            }
+        }
+
+        return grade;
+    }
+
+    /**
+     * judgedStartTime is the note's start time plus judgment offset; holdingStartTime is float.MaxValue if the note
+     * was never held.
+     */
+    public static NoteGrade GradeHold(GameMode mode, float duration, float heldDuration, float holdingStartTime,
+        float judgedStartTime, ref float greatGradeWeight)
+    {
+        var grade = NoteGrade.Miss;
+        var rankedGrade = NoteGrade.Miss;
+        if (heldDuration > duration - 0.05f) grade = NoteGrade.Perfect;
+        else if (heldDuration > duration * 0.7f) grade = NoteGrade.Great;
+        else if (heldDuration > duration * 0.5f) grade = NoteGrade.Good;
+        else if (heldDuration > duration * 0.3f) grade = NoteGrade.Bad;
+
+        if (mode != GameMode.Practice)
+        {
+            if (holdingStartTime != float.MaxValue && Mathf.Max(holdingStartTime, judgedStartTime) > judgedStartTime)
+            {
+                var lateBy = holdingStartTime - judgedStartTime;
+                if (lateBy < 0.200f) rankedGrade = NoteGrade.Bad;
+                if (lateBy < 0.150f) rankedGrade = NoteGrade.Good;
+                if (lateBy < 0.070f) rankedGrade = NoteGrade.Great;
+                if (lateBy <= 0.040f) rankedGrade = NoteGrade.Perfect;
+                if (rankedGrade == NoteGrade.Great) greatGradeWeight = 1.0f - (lateBy - 0.040f) / (0.070f - 0.040f);
+            }
+            else
+            {
+                rankedGrade = grade;
+                if (rankedGrade == NoteGrade.Great) greatGradeWeight = 1.0f - (heldDuration - duration * 0.70f) /
+                                                                     (duration - 0.050f - duration * 0.70f);
+            }
+        }
+
+        if (mode != GameMode.Practice && rankedGrade < grade)
+            return rankedGrade; // Return the "worse" ranking (Note miss < bad < good < great < perfect)
+        return grade;
+    }
+}
@@ -1,5 +1,4 @@
-﻿using System.Linq.Expressions;
-using UnityEngine;
+﻿using UnityEngine;
 
 public class NoteRenderer
 {
@@ -20,11 +19,17 @@ public class NoteRenderer
         Render();
     }
 
-    protected virtual void Render() => Expression.Empty();
+    protected virtual void Render()
+    {
+    }
 
-    public virtual void OnNoteLoaded() => Expression.Empty();
+    public virtual void OnNoteLoaded()
+    {
+    }
 
-    public virtual void OnClear(NoteGrade grade) => Expression.Empty();
+    public virtual void OnClear(NoteGrade grade)
+    {
+    }
 
     public bool DoesCollide(Vector2 pos)
     {
@@ -41,6 +46,8 @@ public class NoteRenderer
         }
     }
     
-    public virtual void Dispose() => Expression.Empty();
+    public virtual void Dispose()
+    {
+    }
     
 }
\ No newline at end of file
@@ -47,12 +47,19 @@ public class ObjectPool
         initialNoteObjectCount[type] = count;
     }
 
+    /**
+     * Pads a peak concurrent object count so that small timing differences (judgement offset, frame time) do not
+     * cause instantiation during gameplay.
+     */
+    public static int WithSafetyMargin(int peakCount)
+    {
+        return peakCount + Mathf.Max(2, Mathf.CeilToInt(peakCount * 0.1f));
+    }
+
     public void Initialize()
     {
-        initialDragLineObjectCount = initialNoteObjectCount[NoteType.DragHead] 
-                                     + initialNoteObjectCount[NoteType.DragChild]
-                                     + initialNoteObjectCount[NoteType.CDragHead] 
-                                     + initialNoteObjectCount[NoteType.CDragChild];
+        var chart = Game.Chart;
+        initialDragLineObjectCount = WithSafetyMargin(chart.MaxConcurrentDragLineCount);
         var timer = new BenchmarkTimer("Game ObjectPool");
         foreach (var type in initialNoteObjectCount.Keys)
         {
@@ -67,30 +74,33 @@ public class ObjectPool
             Collect(dragLinePoolItem, Instantiate(dragLinePoolItem, new PoolItemInstantiateProvider()));
         }
         timer.Time("DragLines");
-        var chart = Game.Chart;
+        // Effects play for their duration divided by the grade's simulation speed (see EffectController)
+        bool IsDragType(NoteType type) => type == NoteType.DragHead || type == NoteType.DragChild || type == NoteType.CDragChild;
+        float GetEffectDuration(EffectController.Effect effect, float minSimulationSpeed) =>
+            Game.effectController.GetPrefab(effect).main.duration / minSimulationSpeed;
         var map = new Dictionary<EffectController.Effect, int>
         {
             {
                 EffectController.Effect.Clear,
-                chart.MaxSamePageNonDragTypeNoteCount * 2
+                chart.GetMaxConcurrentJudgementCount(type => !IsDragType(type), GetEffectDuration(EffectController.Effect.Clear, 0.5f))
             },
             {
                 EffectController.Effect.ClearDrag, 
-                chart.MaxSamePageDragTypeNoteCount * 2
+                chart.GetMaxConcurrentJudgementCount(IsDragType, GetEffectDuration(EffectController.Effect.ClearDrag, 0.5f))
             },
             {
                 EffectController.Effect.Miss,
-                chart.MaxSamePageNoteCount * 2
+                chart.GetMaxConcurrentJudgementCount(type => true, GetEffectDuration(EffectController.Effect.Miss, 0.3f))
             },
             {
                 EffectController.Effect.Hold, 
-                chart.MaxSamePageHoldTypeNoteCount * 16 * 2
+                chart.GetMaxConcurrentJudgementCount(type => type == NoteType.Hold || type == NoteType.LongHold, GetEffectDuration(EffectController.Effect.Hold, 1f))
             }
         };
         foreach (var pair in map)
         {
             var effect = pair.Key;
-            var count = pair.Value;
+            var count = WithSafetyMargin(pair.Value);
             Debug.Log($"{effect} => {count}");
             for (var i = 0; i < count; i++)
             {
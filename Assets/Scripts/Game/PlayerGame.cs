@@ -86,9 +86,10 @@ public class PlayerGame : Game
         Storyboard.Dispose();
         Storyboard.Renderer.Dispose();
 
-        foreach (var (id, note) in Chart.Model.note_map.Select(it => (it.Key, it.Value)))
+        var notes = Chart.Model.note_map;
+        for (var id = 0; id < notes.Length; id++)
         {
-            note.PasteFrom(originalChartModel.note_map[id]);
+            notes[id]?.PasteFrom(originalChartModel.note_map[id]);
         }
 
         Storyboard = new Cytoid.Storyboard.Storyboard(this, File.ReadAllText(StoryboardPath));
@@ -136,10 +137,12 @@ public class PlayerGame : Game
         Music.PlaybackTime = value * MusicLength;
         Storyboard?.Renderer.Clear();
 
+        Chart.CurrentPageId = Chart.GetPageIndexAtTime(Music.PlaybackTime - Config.ChartOffset + Chart.MusicOffset);
         Chart.Model.note_list.LastOrDefault(it => it.intro_time - 1f < Music.PlaybackTime)?.Apply(it =>
         {
             Chart.CurrentNoteId = it.id;
         });
+        Chart.CurrentDragLineSegmentId = Chart.GetDragLineSegmentIndexAtTime(Music.PlaybackTime - Config.ChartOffset + Chart.MusicOffset);
     }
 
     protected override async void StartGame()
@@ -172,6 +175,8 @@ public class PlayerGame : Game
                 Music.Play(AudioTrackIndex.Reserved1);
 
                 Chart.CurrentNoteId = 0;
+                Chart.CurrentPageId = 0;
+                Chart.CurrentDragLineSegmentId = 0;
             }
         }
         Time = Music.PlaybackTime - Config.ChartOffset + Chart.MusicOffset;
@@ -39,20 +39,21 @@ public sealed class TierState
     public int LateCount => Stages.Sum(it => it.LateCount);
     
     [AvailableOnComplete]
-    public double AverageTimingError => OnCompleteGuard(Stages.Sum(state => state.Judgements.Values.Sum(it => it.Error)) / Stages.Sum(it => it.Judgements.Count));
-
-    [AvailableOnComplete]
-    public double StandardTimingError
+    public RunningStatistics TimingErrors
     {
         get
         {
             OnCompleteGuard();
-            var difference = 0.0;
-            Stages.ForEach(state => state.Judgements.Values.ForEach(it => difference += Math.Pow(AverageTimingError - it.Error, 2)));
-            return Math.Sqrt(difference / Stages.Sum(it => it.Judgements.Count));
+            var statistics = new RunningStatistics();
+            foreach (var stage in Stages) statistics = RunningStatistics.Combine(statistics, stage.TimingErrors);
+            return statistics;
         }
     }
 
+    [AvailableOnComplete] public double AverageTimingError => TimingErrors.Mean;
+
+    [AvailableOnComplete] public double StandardTimingError => Math.Sqrt(TimingErrors.Variance);
+
     private Dictionary<NoteGrade, int> gradeCounts = new Dictionary<NoteGrade, int>();
 
     public TierState(TierData tier)
@@ -127,17 +127,20 @@ public class ResultScreen : Screen
                                   $"<b>{"RESULT_STD_TIMING_ERR".Get()}</b> {gameState.StandardTimingError:0.000}s";
         if (!Context.Player.Settings.DisplayEarlyLateIndicators) advancedMetricText.text = "";
         
-        var record = gameState.Level.Record;
-        record.IncrementPlayCountByOne(gameState.Difficulty);
-        newBestText.text = record.TrySaveBestPerformance(gameState.Mode, gameState.Difficulty, (int) gameState.Score, gameState.Accuracy);
-        gameState.Level.SaveRecord();
+        if (!gameState.IsPlayback)
+        {
+            var record = gameState.Level.Record;
+            record.IncrementPlayCountByOne(gameState.Difficulty);
+            newBestText.text = record.TrySaveBestPerformance(gameState.Mode, gameState.Difficulty, (int) gameState.Score, gameState.Accuracy);
+            gameState.Level.SaveRecord();
+        }
 
         shareButton.onPointerClick.SetListener(_ => StartCoroutine(Share()));
 
         ProfileWidget.Instance.Enter();
         upperRightColumn.Enter();
         
-        if (Context.IsOnline() && Context.OnlinePlayer.IsAuthenticated)
+        if (Context.IsOnline() && Context.OnlinePlayer.IsAuthenticated && !gameState.IsPlayback)
         {
             UploadRecord();
         }
@@ -248,6 +251,7 @@ public class ResultScreen : Screen
 
     public void UploadRecord()
     {
+        if (gameState.IsPlayback) throw new InvalidOperationException("Cannot upload the record of an input replay");
         var usedAuto =  gameState.Mods.Contains(Mod.Auto) || gameState.Mods.Contains(Mod.AutoDrag) || gameState.Mods.Contains(Mod.AutoHold) || gameState.Mods.Contains(Mod.AutoFlick);
         if (!Application.isEditor && usedAuto) throw new Exception();
         
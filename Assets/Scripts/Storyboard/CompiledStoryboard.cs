@@ -0,0 +1,509 @@
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Reflection;
+using System.Text;
+
+namespace Cytoid.Storyboard
+{
+    /**
+     * Binary form of a parsed storyboard, written by Storyboard.Compile and read back without building a JSON DOM.
+     *
+     * Layout: magic, version and a string table (ids, paths, texts and field names are written as indices into it),
+     * followed by one section per object type. Each section starts with the schema of its state type (field names and
+     * value types), so that a reader can skip fields it does not know. Each object is written as its ids and states;
+     * each state is a bitmask of the fields that are set, followed by their values.
+     */
+    public class CompiledStoryboard
+    {
+        private const int Magic = 0x42535943; // "CYSB"
+        private const int Version = 1;
+
+        public readonly List<Text> Texts = new List<Text>();
+        public readonly List<Sprite> Sprites = new List<Sprite>();
+        public readonly List<Video> Videos = new List<Video>();
+        public readonly List<Line> Lines = new List<Line>();
+        public readonly List<Controller> Controllers = new List<Controller>();
+        public readonly List<NoteController> NoteControllers = new List<NoteController>();
+
+        private enum FieldType : byte
+        {
+            Float = 0,
+            Int = 1, // Also enums
+            Bool = 2,
+            String = 3,
+            UnitFloat = 4,
+            Color = 5,
+            LinePositions = 6,
+            Colors = 7
+        }
+
+        private class Field
+        {
+            public string Name; // Qualified with the declaring type, as some state types hide fields of their base
+            public FieldType Type;
+            public FieldInfo Info;
+            public Type EnumType;
+        }
+
+        private static readonly Dictionary<Type, Field[]> Schemas = new Dictionary<Type, Field[]>();
+
+        public static bool IsCompiled(string path)
+        {
+            using (var stream = File.OpenRead(path))
+            {
+                if (stream.Length < 4) return false;
+                using (var reader = new BinaryReader(stream))
+                {
+                    return reader.ReadInt32() == Magic;
+                }
+            }
+        }
+
+        public static CompiledStoryboard Load(string path)
+        {
+            using (var stream = new FileStream(path, FileMode.Open, FileAccess.Read, FileShare.Read, 64 * 1024))
+            {
+                return Read(stream);
+            }
+        }
+
+        public static void Write(Storyboard storyboard, Stream stream)
+        {
+            var strings = new List<string>();
+            var stringIndices = new Dictionary<string, int>();
+
+            // The string table is only complete after the sections have been written
+            using (var body = new MemoryStream())
+            {
+                using (var writer = new BinaryWriter(body, Encoding.UTF8, true))
+                {
+                    var context = new WriteContext {Writer = writer, Strings = strings, StringIndices = stringIndices};
+                    WriteSection<Text, TextState>(context, storyboard.Texts.Values);
+                    WriteSection<Sprite, SpriteState>(context, storyboard.Sprites.Values);
+                    WriteSection<Video, VideoState>(context, storyboard.Videos.Values);
+                    WriteSection<Line, LineState>(context, storyboard.Lines.Values);
+                    WriteSection<Controller, ControllerState>(context, storyboard.Controllers.Values);
+                    WriteSection<NoteController, NoteControllerState>(context, storyboard.NoteControllers.Values);
+                }
+
+                using (var writer = new BinaryWriter(stream, Encoding.UTF8, true))
+                {
+                    writer.Write(Magic);
+                    writer.Write(Version);
+                    WriteVarUInt(writer, (uint) strings.Count);
+                    foreach (var it in strings) writer.Write(it);
+                    body.Position = 0;
+                    writer.Flush();
+                    body.CopyTo(stream);
+                }
+            }
+        }
+
+        /**
+         * Reads a compiled storyboard. A truncated or malformed stream throws InvalidDataException.
+         */
+        public static CompiledStoryboard Read(Stream stream)
+        {
+            try
+            {
+                return ReadUnchecked(stream);
+            }
+            catch (EndOfStreamException e)
+            {
+                throw new InvalidDataException("Truncated compiled storyboard", e);
+            }
+        }
+
+        private static CompiledStoryboard ReadUnchecked(Stream stream)
+        {
+            using (var reader = new BinaryReader(stream, Encoding.UTF8, true))
+            {
+                if (reader.ReadInt32() != Magic) throw new InvalidDataException("Not a compiled storyboard");
+                var version = reader.ReadInt32();
+                if (version != Version) throw new InvalidDataException($"Unsupported compiled storyboard version {version}");
+
+                var strings = new string[ReadCount(reader)];
+                for (var i = 0; i < strings.Length; i++) strings[i] = reader.ReadString();
+
+                var context = new ReadContext {Reader = reader, Strings = strings};
+                var storyboard = new CompiledStoryboard();
+                ReadSection<Text, TextState>(context, storyboard.Texts);
+                ReadSection<Sprite, SpriteState>(context, storyboard.Sprites);
+                ReadSection<Video, VideoState>(context, storyboard.Videos);
+                ReadSection<Line, LineState>(context, storyboard.Lines);
+                ReadSection<Controller, ControllerState>(context, storyboard.Controllers);
+                ReadSection<NoteController, NoteControllerState>(context, storyboard.NoteControllers);
+                return storyboard;
+            }
+        }
+
+        #region Writing
+
+        private class WriteContext
+        {
+            public BinaryWriter Writer;
+            public List<string> Strings;
+            public Dictionary<string, int> StringIndices;
+
+            // 0 is null
+            public void WriteString(string value)
+            {
+                if (value == null)
+                {
+                    WriteVarUInt(Writer, 0);
+                    return;
+                }
+                if (!StringIndices.TryGetValue(value, out var index))
+                {
+                    index = Strings.Count;
+                    Strings.Add(value);
+                    StringIndices[value] = index;
+                }
+                WriteVarUInt(Writer, (uint) index + 1);
+            }
+        }
+
+        private static void WriteSection<TO, TS>(WriteContext context, ICollection<TO> objects)
+            where TO : Object<TS> where TS : ObjectState
+        {
+            var writer = context.Writer;
+            var schema = GetSchema(typeof(TS));
+            WriteVarUInt(writer, (uint) schema.Length);
+            foreach (var field in schema)
+            {
+                context.WriteString(field.Name);
+                writer.Write((byte) field.Type);
+            }
+
+            var values = new object[schema.Length];
+            var mask = new byte[(schema.Length + 7) / 8];
+            WriteVarUInt(writer, (uint) objects.Count);
+            foreach (var obj in objects)
+            {
+                context.WriteString(obj.Id);
+                context.WriteString(obj.TargetId);
+                context.WriteString(obj.ParentId);
+                WriteVarUInt(writer, (uint) obj.States.Count);
+                foreach (var state in obj.States)
+                {
+                    Array.Clear(mask, 0, mask.Length);
+                    for (var i = 0; i < schema.Length; i++)
+                    {
+                        values[i] = schema[i].Info.GetValue(state); // Unset nullables are boxed as null
+                        if (values[i] != null) mask[i / 8] |= (byte) (1 << (i % 8));
+                    }
+                    writer.Write(mask);
+                    for (var i = 0; i < schema.Length; i++)
+                    {
+                        if (values[i] != null) WriteValue(context, schema[i].Type, values[i]);
+                    }
+                }
+            }
+        }
+
+        private static void WriteValue(WriteContext context, FieldType type, object value)
+        {
+            var writer = context.Writer;
+            switch (type)
+            {
+                case FieldType.Float:
+                    writer.Write((float) value);
+                    break;
+                case FieldType.Int:
+                    writer.Write(Convert.ToInt32(value));
+                    break;
+                case FieldType.Bool:
+                    writer.Write((bool) value);
+                    break;
+                case FieldType.String:
+                    context.WriteString((string) value);
+                    break;
+                case FieldType.UnitFloat:
+                    WriteUnitFloat(writer, (UnitFloat) value);
+                    break;
+                case FieldType.Color:
+                    WriteColor(writer, (Color) value);
+                    break;
+                case FieldType.LinePositions:
+                {
+                    var positions = (List<LinePosition>) value;
+                    WriteVarUInt(writer, (uint) positions.Count);
+                    foreach (var position in positions)
+                    {
+                        writer.Write((byte) ((position.X != null ? 1 : 0) | (position.Y != null ? 2 : 0) |
+                                             (position.Z != null ? 4 : 0)));
+                        if (position.X != null) WriteUnitFloat(writer, position.X);
+                        if (position.Y != null) WriteUnitFloat(writer, position.Y);
+                        if (position.Z != null) WriteUnitFloat(writer, position.Z);
+                    }
+                    break;
+                }
+                case FieldType.Colors:
+                {
+                    var colors = (List<Color>) value;
+                    WriteVarUInt(writer, (uint) colors.Count);
+                    foreach (var color in colors)
+                    {
+                        writer.Write(color != null);
+                        if (color != null) WriteColor(writer, color);
+                    }
+                    break;
+                }
+                default:
+                    throw new ArgumentOutOfRangeException(nameof(type), type, null);
+            }
+        }
+
+        private static void WriteUnitFloat(BinaryWriter writer, UnitFloat value)
+        {
+            writer.Write(value.Value);
+            writer.Write((byte) value.Unit);
+            writer.Write(value.ScaleToCanvas);
+            writer.Write(value.Span);
+        }
+
+        private static void WriteColor(BinaryWriter writer, Color value)
+        {
+            writer.Write(value.R);
+            writer.Write(value.G);
+            writer.Write(value.B);
+            writer.Write(value.A);
+        }
+
+        private static void WriteVarUInt(BinaryWriter writer, uint value)
+        {
+            while (value >= 0x80)
+            {
+                writer.Write((byte) (value | 0x80));
+                value >>= 7;
+            }
+            writer.Write((byte) value);
+        }
+
+        #endregion
+
+        #region Reading
+
+        private class ReadContext
+        {
+            public BinaryReader Reader;
+            public string[] Strings;
+
+            public string ReadString()
+            {
+                var index = ReadVarUInt(Reader);
+                if (index > Strings.Length) throw new InvalidDataException($"Malformed string index {index}");
+                return index == 0 ? null : Strings[index - 1];
+            }
+        }
+
+        private static void ReadSection<TO, TS>(ReadContext context, List<TO> objects)
+            where TO : Object<TS>, new() where TS : ObjectState, new()
+        {
+            var reader = context.Reader;
+
+            // Map the file's schema to the fields of this build; unknown or retyped fields are read and discarded
+            var localFields = new Dictionary<string, Field>();
+            foreach (var field in GetSchema(typeof(TS))) localFields[field.Name] = field;
+            var fileFieldCount = ReadCount(reader);
+            var fileTypes = new FieldType[fileFieldCount];
+            var targets = new Field[fileFieldCount];
+            for (var i = 0; i < fileFieldCount; i++)
+            {
+                var name = context.ReadString();
+                fileTypes[i] = (FieldType) reader.ReadByte();
+                if (name != null && localFields.TryGetValue(name, out var field) && field.Type == fileTypes[i])
+                {
+                    targets[i] = field;
+                }
+            }
+
+            // Fields that a new state initializes to a value (e.g. LineState.Pos), which have to be reset if written unset
+            var defaultState = new TS();
+            var resetFields = new List<int>();
+            for (var i = 0; i < fileFieldCount; i++)
+            {
+                if (targets[i] != null && targets[i].Info.GetValue(defaultState) != null &&
+                    (!targets[i].Info.FieldType.IsValueType || Nullable.GetUnderlyingType(targets[i].Info.FieldType) != null))
+                {
+                    resetFields.Add(i);
+                }
+            }
+
+            var mask = new byte[(fileFieldCount + 7) / 8];
+            var objectCount = ReadCount(reader);
+            objects.Capacity = objects.Count + objectCount;
+            for (var o = 0; o < objectCount; o++)
+            {
+                var obj = new TO
+                {
+                    Id = context.ReadString(),
+                    TargetId = context.ReadString(),
+                    ParentId = context.ReadString()
+                };
+                var stateCount = ReadCount(reader);
+                obj.States = new List<TS>(stateCount);
+                for (var s = 0; s < stateCount; s++)
+                {
+                    var state = new TS();
+                    for (var i = 0; i < mask.Length; i++) mask[i] = reader.ReadByte();
+                    for (var i = 0; i < fileFieldCount; i++)
+                    {
+                        if ((mask[i / 8] & (1 << (i % 8))) == 0) continue;
+                        var value = ReadValue(context, fileTypes[i]);
+                        var target = targets[i];
+                        if (target == null) continue;
+                        if (target.EnumType != null) value = Enum.ToObject(target.EnumType, (int) value);
+                        target.Info.SetValue(state, value);
+                    }
+                    foreach (var i in resetFields)
+                    {
+                        if ((mask[i / 8] & (1 << (i % 8))) == 0) targets[i].Info.SetValue(state, null);
+                    }
+                    obj.States.Add(state);
+                }
+                objects.Add(obj);
+            }
+        }
+
+        private static object ReadValue(ReadContext context, FieldType type)
+        {
+            var reader = context.Reader;
+            switch (type)
+            {
+                case FieldType.Float:
+                    return reader.ReadSingle();
+                case FieldType.Int:
+                    return reader.ReadInt32();
+                case FieldType.Bool:
+                    return reader.ReadBoolean();
+                case FieldType.String:
+                    return context.ReadString();
+                case FieldType.UnitFloat:
+                    return ReadUnitFloat(reader);
+                case FieldType.Color:
+                    return ReadColor(reader);
+                case FieldType.LinePositions:
+                {
+                    var count = ReadCount(reader);
+                    var positions = new List<LinePosition>(count);
+                    for (var i = 0; i < count; i++)
+                    {
+                        var present = reader.ReadByte();
+                        positions.Add(new LinePosition
+                        {
+                            X = (present & 1) != 0 ? ReadUnitFloat(reader) : null,
+                            Y = (present & 2) != 0 ? ReadUnitFloat(reader) : null,
+                            Z = (present & 4) != 0 ? ReadUnitFloat(reader) : null
+                        });
+                    }
+                    return positions;
+                }
+                case FieldType.Colors:
+                {
+                    var count = ReadCount(reader);
+                    var colors = new List<Color>(count);
+                    for (var i = 0; i < count; i++)
+                    {
+                        colors.Add(reader.ReadBoolean() ? ReadColor(reader) : null);
+                    }
+                    return colors;
+                }
+                default:
+                    throw new InvalidDataException($"Unknown field type {type}");
+            }
+        }
+
+        private static UnitFloat ReadUnitFloat(BinaryReader reader)
+        {
+            var value = reader.ReadSingle();
+            var unit = (ReferenceUnit) reader.ReadByte();
+            var scaleToCanvas = reader.ReadBoolean();
+            var span = reader.ReadBoolean();
+            return new UnitFloat(value, unit, scaleToCanvas, span);
+        }
+
+        private static Color ReadColor(BinaryReader reader)
+        {
+            return new Color
+            {
+                R = reader.ReadSingle(),
+                G = reader.ReadSingle(),
+                B = reader.ReadSingle(),
+                A = reader.ReadSingle()
+            };
+        }
+
+        /**
+         * Reads the length of a list, which is checked against the bytes left in the stream before anything is
+         * allocated for it: every item takes at least one byte.
+         */
+        private static int ReadCount(BinaryReader reader)
+        {
+            var count = ReadVarUInt(reader);
+            var stream = reader.BaseStream;
+            if (count > int.MaxValue || stream.CanSeek && count > stream.Length - stream.Position)
+            {
+                throw new InvalidDataException($"Malformed count {count}");
+            }
+            return (int) count;
+        }
+
+        private static uint ReadVarUInt(BinaryReader reader)
+        {
+            uint value = 0;
+            var shift = 0;
+            byte b;
+            do
+            {
+                if (shift > 28) throw new InvalidDataException("Malformed varint");
+                b = reader.ReadByte();
+                value |= (uint) (b & 0x7F) << shift;
+                shift += 7;
+            } while ((b & 0x80) != 0);
+            return value;
+        }
+
+        #endregion
+
+        private static Field[] GetSchema(Type stateType)
+        {
+            lock (Schemas)
+            {
+                if (Schemas.TryGetValue(stateType, out var schema)) return schema;
+
+                var fields = stateType.GetFields(BindingFlags.Public | BindingFlags.Instance);
+                schema = new Field[fields.Length];
+                for (var i = 0; i < fields.Length; i++)
+                {
+                    var info = fields[i];
+                    var fieldType = Nullable.GetUnderlyingType(info.FieldType) ?? info.FieldType;
+                    schema[i] = new Field
+                    {
+                        Name = info.DeclaringType.Name + "." + info.Name,
+                        Type = ToFieldType(fieldType, info),
+                        Info = info,
+                        EnumType = fieldType.IsEnum ? fieldType : null
+                    };
+                }
+                Array.Sort(schema, (a, b) => string.CompareOrdinal(a.Name, b.Name));
+                return Schemas[stateType] = schema;
+            }
+        }
+
+        private static FieldType ToFieldType(Type type, FieldInfo info)
+        {
+            if (type == typeof(float)) return FieldType.Float;
+            if (type == typeof(int) || type.IsEnum) return FieldType.Int;
+            if (type == typeof(bool)) return FieldType.Bool;
+            if (type == typeof(string)) return FieldType.String;
+            if (type == typeof(UnitFloat)) return FieldType.UnitFloat;
+            if (type == typeof(Color)) return FieldType.Color;
+            if (type == typeof(List<LinePosition>)) return FieldType.LinePositions;
+            if (type == typeof(List<Color>)) return FieldType.Colors;
+            throw new NotSupportedException(
+                $"Storyboard: Field {info.DeclaringType.Name}.{info.Name} of type {type.Name} cannot be compiled");
+        }
+    }
+}
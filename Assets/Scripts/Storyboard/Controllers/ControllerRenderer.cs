@@ -13,6 +13,8 @@ namespace Cytoid.Storyboard.Controllers
         public override Transform Transform => throw new InvalidOperationException();
         
         public override bool IsOnCanvas => false;
+
+        public override bool UpdatesAfterLastState => true; // Effects such as the shockwave are reset every frame
         
         public ControllerRenderer(StoryboardRenderer mainRenderer, Controller component) : base(mainRenderer, component)
         {
@@ -1,7 +1,6 @@
 using System.Collections.Generic;
 using System.Linq;
 using Newtonsoft.Json.Linq;
-using UnityEngine;
 
 namespace Cytoid.Storyboard.Controllers
 {
@@ -30,14 +29,14 @@ namespace Cytoid.Storyboard.Controllers
             state.RotY = (float?) json.SelectToken("rot_y") ?? state.RotY;
             state.RotZ = (float?) json.SelectToken("rot_z") ?? state.RotZ;
 
-            if (ColorUtility.TryParseHtmlString((string) json.SelectToken("scanline_color"), out var tmp))
+            if (TryParseHtmlString((string) json.SelectToken("scanline_color"), out var tmp))
                 state.ScanlineColor = new Color {R = tmp.r, G = tmp.g, B = tmp.b, A = tmp.a};
             state.ScanlineSmoothing = (bool?) json.SelectToken("scanline_smoothing") ?? state.ScanlineSmoothing;
             state.OverrideScanlinePos = (bool?) json.SelectToken("override_scanline_pos") ?? state.OverrideScanlinePos;
             state.ScanlinePos = ParseUnitFloat(json.SelectToken("scanline_pos"), ReferenceUnit.NoteY, false, false) ?? state.ScanlinePos;
             state.NoteOpacityMultiplier =
                 (float?) json.SelectToken("note_opacity_multiplier") ?? state.NoteOpacityMultiplier;
-            if (ColorUtility.TryParseHtmlString((string) json.SelectToken("note_ring_color"), out tmp))
+            if (TryParseHtmlString((string) json.SelectToken("note_ring_color"), out tmp))
                 state.NoteRingColor = new Color {R = tmp.r, G = tmp.g, B = tmp.b, A = tmp.a};
             var fillColors = json.SelectToken("note_fill_colors") != null &&
                              json.SelectToken("note_fill_colors").Type != JTokenType.Null
@@ -55,7 +54,7 @@ namespace Cytoid.Storyboard.Controllers
                     }
 
                     var fillColor = fillColors[i];
-                    if (ColorUtility.TryParseHtmlString(fillColor, out tmp))
+                    if (TryParseHtmlString(fillColor, out tmp))
                         state.NoteFillColors.Add(new Color {R = tmp.r, G = tmp.g, B = tmp.b, A = tmp.a});
                 }
             }
@@ -66,7 +65,7 @@ namespace Cytoid.Storyboard.Controllers
             state.Vignette = (bool?) json.SelectToken("vignette") ?? state.Vignette;
             state.VignetteIntensity = (float?) json.SelectToken("vignette_intensity") ?? state.VignetteIntensity;
 
-            if (ColorUtility.TryParseHtmlString((string) json.SelectToken("vignette_color"), out tmp))
+            if (TryParseHtmlString((string) json.SelectToken("vignette_color"), out tmp))
                 state.VignetteColor = new Color {R = tmp.r, G = tmp.g, B = tmp.b, A = tmp.a};
             state.VignetteStart = (float?) json.SelectToken("vignette_start") ?? state.VignetteStart;
             state.VignetteEnd = (float?) json.SelectToken("vignette_end") ?? state.VignetteEnd;
@@ -85,7 +84,7 @@ namespace Cytoid.Storyboard.Controllers
             state.Contrast = (float?) json.SelectToken("contrast") ?? state.Contrast;
 
             state.ColorFilter = (bool?) json.SelectToken("color_filter") ?? state.ColorFilter;
-            if (ColorUtility.TryParseHtmlString((string) json.SelectToken("color_filter_color"), out tmp))
+            if (TryParseHtmlString((string) json.SelectToken("color_filter_color"), out tmp))
                 state.ColorFilterColor = new Color {R = tmp.r, G = tmp.g, B = tmp.b, A = tmp.a};
 
             state.GrayScale = (bool?) json.SelectToken("gray_scale") ?? state.GrayScale;
@@ -110,7 +109,7 @@ namespace Cytoid.Storyboard.Controllers
             state.FocusIntensity = (float?) json.SelectToken("focus_intensity") ?? state.FocusIntensity;
             state.FocusSize = (float?) json.SelectToken("focus_size") ?? state.FocusSize;
             state.FocusSpeed = (float?) json.SelectToken("focus_speed") ?? state.FocusSpeed;
-            if (ColorUtility.TryParseHtmlString((string) json.SelectToken("focus_color"), out tmp))
+            if (TryParseHtmlString((string) json.SelectToken("focus_color"), out tmp))
                 state.FocusColor = new Color {R = tmp.r, G = tmp.g, B = tmp.b, A = tmp.a};
 
             state.Glitch = (bool?) json.SelectToken("glitch") ?? state.Glitch;
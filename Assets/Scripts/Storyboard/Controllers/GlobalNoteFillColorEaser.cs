@@ -24,6 +24,7 @@ namespace Cytoid.Storyboard.Controllers
                         EaseColor(From.NoteFillColors[value[1]], To.NoteFillColors[value[1]])
                     };
                 }
+                Game.Config.OverrideVersion++;
             }
         }
     }
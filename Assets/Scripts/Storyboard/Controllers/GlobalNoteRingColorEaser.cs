@@ -11,6 +11,7 @@ namespace Cytoid.Storyboard.Controllers
             if (From.NoteRingColor != null)
             {
                 Game.Config.GlobalRingColorOverride = EaseColor(From.NoteRingColor, To.NoteRingColor);
+                Game.Config.OverrideVersion++;
             }
         }
     }
@@ -1,4 +1,5 @@
 using System;
+using System.Collections.Generic;
 using Newtonsoft.Json;
 using Newtonsoft.Json.Linq;
 using UnityEngine;
@@ -12,6 +13,33 @@ namespace Cytoid.Storyboard
     
     public abstract class GenericStateParser<TS> : StateParser where TS : ObjectState 
     {
+        private static readonly Dictionary<string, Color32> HtmlColorNames =
+            new Dictionary<string, Color32>(StringComparer.OrdinalIgnoreCase)
+            {
+                {"red", new Color32(255, 0, 0, 255)},
+                {"cyan", new Color32(0, 255, 255, 255)},
+                {"blue", new Color32(0, 0, 255, 255)},
+                {"darkblue", new Color32(0, 0, 160, 255)},
+                {"lightblue", new Color32(173, 216, 230, 255)},
+                {"purple", new Color32(128, 0, 128, 255)},
+                {"yellow", new Color32(255, 255, 0, 255)},
+                {"lime", new Color32(0, 255, 0, 255)},
+                {"fuchsia", new Color32(255, 0, 255, 255)},
+                {"white", new Color32(255, 255, 255, 255)},
+                {"silver", new Color32(192, 192, 192, 255)},
+                {"grey", new Color32(128, 128, 128, 255)},
+                {"black", new Color32(0, 0, 0, 255)},
+                {"orange", new Color32(255, 165, 0, 255)},
+                {"brown", new Color32(165, 42, 42, 255)},
+                {"maroon", new Color32(128, 0, 0, 255)},
+                {"green", new Color32(0, 128, 0, 255)},
+                {"olive", new Color32(128, 128, 0, 255)},
+                {"navy", new Color32(0, 0, 128, 255)},
+                {"teal", new Color32(0, 128, 128, 255)},
+                {"aqua", new Color32(0, 255, 255, 255)},
+                {"magenta", new Color32(255, 0, 255, 255)}
+            };
+
         public Storyboard Storyboard { get; }
 
         public GenericStateParser(Storyboard storyboard)
@@ -80,6 +108,49 @@ namespace Cytoid.Storyboard
             state.Order = (int?) json.SelectToken("order") ?? state.Order;
         }
         
+        /**
+         * Same as ColorUtility.TryParseHtmlString (#RGB, #RGBA, #RRGGBB, #RRGGBBAA or a color name), which can only be
+         * called from the main thread; states are parsed on the thread pool.
+         */
+        protected static bool TryParseHtmlString(string htmlString, out UnityEngine.Color color)
+        {
+            color = default;
+            if (string.IsNullOrEmpty(htmlString)) return false;
+
+            if (htmlString[0] != '#')
+            {
+                if (!HtmlColorNames.TryGetValue(htmlString, out var namedColor)) return false;
+                color = namedColor;
+                return true;
+            }
+
+            var digits = htmlString.Length - 1;
+            if (digits != 3 && digits != 4 && digits != 6 && digits != 8) return false;
+            var channels = new byte[] {0, 0, 0, 255};
+            var digitsPerChannel = digits <= 4 ? 1 : 2;
+            for (var i = 0; i < digits / digitsPerChannel; i++)
+            {
+                var value = 0;
+                for (var j = 0; j < digitsPerChannel; j++)
+                {
+                    var digit = ParseHexDigit(htmlString[1 + i * digitsPerChannel + j]);
+                    if (digit < 0) return false;
+                    value = value * 16 + digit;
+                }
+                channels[i] = (byte) (digitsPerChannel == 1 ? value * 17 : value);
+            }
+            color = new Color32(channels[0], channels[1], channels[2], channels[3]);
+            return true;
+        }
+
+        private static int ParseHexDigit(char c)
+        {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+            if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+            return -1;
+        }
+
         protected UnitFloat ParseUnitFloat(JToken token, ReferenceUnit defaultUnit, bool scaleToCanvas, bool span, float? defaultValue = null)
         {
             if (token == null)
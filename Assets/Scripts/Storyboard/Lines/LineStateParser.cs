@@ -1,7 +1,6 @@
 using System.Collections.Generic;
 using System.Linq;
 using Newtonsoft.Json.Linq;
-using UnityEngine;
 
 namespace Cytoid.Storyboard.Lines
 {
@@ -30,7 +29,7 @@ namespace Cytoid.Storyboard.Lines
                 });
             }
             state.Width = ParseUnitFloat(json.SelectToken("width"), ReferenceUnit.World, false, true) ?? state.Width;
-            if (ColorUtility.TryParseHtmlString((string) json.SelectToken("color"), out var tmp))
+            if (TryParseHtmlString((string) json.SelectToken("color"), out var tmp))
                 state.Color = new Color {R = tmp.r, G = tmp.g, B = tmp.b, A = tmp.a};
             state.Opacity = (float?) json.SelectToken("opacity") ?? state.Opacity;
             state.Layer = (int?) json.SelectToken("layer") ?? state.Layer;
@@ -0,0 +1,199 @@
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+
+namespace Cytoid.Storyboard
+{
+    /**
+     * Chart notes indexed for note selectors: per type sorted by id, and per type and direction sorted by x. A selector
+     * is resolved by intersecting its id range or its x range (whichever has fewer candidates) with the other
+     * conditions, and its result is cached, so identical selectors are only resolved once.
+     *
+     * Results are in chart note list order, which is the order selectors have always been expanded in. Selectors that
+     * match a large part of the chart are resolved by scanning the whole note list, which is already in that order.
+     */
+    public class NoteSelectorIndex
+    {
+        private struct IndexedNote
+        {
+            public int Order; // Index in the chart note list
+            public int Type;
+            public int Id;
+            public double X;
+            public int Direction;
+        }
+
+        // Above 1 / LinearScanRatio of the chart, sorting the candidates costs more than scanning all notes
+        private const int LinearScanRatio = 8;
+
+        private static readonly IComparer<IndexedNote> IdComparer =
+            Comparer<IndexedNote>.Create((a, b) => a.Id.CompareTo(b.Id));
+        private static readonly IComparer<IndexedNote> XComparer =
+            Comparer<IndexedNote>.Create((a, b) => a.X.CompareTo(b.X));
+        private static readonly IComparer<IndexedNote> OrderComparer =
+            Comparer<IndexedNote>.Create((a, b) => a.Order.CompareTo(b.Order));
+
+        private readonly IndexedNote[] allNotes;
+        private readonly Dictionary<int, IndexedNote[]> notesById = new Dictionary<int, IndexedNote[]>();
+        private readonly Dictionary<int, Dictionary<int, IndexedNote[]>> notesByX =
+            new Dictionary<int, Dictionary<int, IndexedNote[]>>(); // Type -> direction -> notes
+        private readonly Dictionary<string, List<int>> results = new Dictionary<string, List<int>>();
+        private readonly List<IndexedNote> matches = new List<IndexedNote>();
+        private readonly List<(IndexedNote[], int, int)> candidateRanges = new List<(IndexedNote[], int, int)>();
+
+        public NoteSelectorIndex(List<ChartModel.Note> notes)
+        {
+            var all = new List<IndexedNote>(notes.Count);
+            var notesByType = new Dictionary<int, List<IndexedNote>>();
+            for (var i = 0; i < notes.Count; i++)
+            {
+                var note = notes[i];
+                if (double.IsNaN(note.x)) continue; // Never within an x range
+                if (!notesByType.TryGetValue(note.type, out var list))
+                {
+                    notesByType[note.type] = list = new List<IndexedNote>();
+                }
+                var indexedNote = new IndexedNote
+                    {Order = i, Type = note.type, Id = note.id, X = note.x, Direction = note.direction};
+                list.Add(indexedNote);
+                all.Add(indexedNote);
+            }
+            allNotes = all.ToArray();
+
+            foreach (var pair in notesByType)
+            {
+                var byId = pair.Value.ToArray();
+                Array.Sort(byId, IdComparer);
+                notesById[pair.Key] = byId;
+
+                var byDirection = new Dictionary<int, List<IndexedNote>>();
+                foreach (var note in pair.Value)
+                {
+                    if (!byDirection.TryGetValue(note.Direction, out var list))
+                    {
+                        byDirection[note.Direction] = list = new List<IndexedNote>();
+                    }
+                    list.Add(note);
+                }
+                var byX = new Dictionary<int, IndexedNote[]>();
+                foreach (var directionPair in byDirection)
+                {
+                    var array = directionPair.Value.ToArray();
+                    Array.Sort(array, XComparer);
+                    byX[directionPair.Key] = array;
+                }
+                notesByX[pair.Key] = byX;
+            }
+        }
+
+        /**
+         * Returns the ids of the notes matched by the selector. The returned list is shared between identical
+         * selectors and must not be modified.
+         */
+        public List<int> Select(NoteSelector selector)
+        {
+            var key = CreateKey(selector);
+            if (results.TryGetValue(key, out var result)) return result;
+
+            // Choose the narrower of the id and x ranges for every type
+            candidateRanges.Clear();
+            var candidates = 0;
+            foreach (var type in selector.Types)
+            {
+                if (!notesById.TryGetValue(type, out var byId)) continue;
+
+                var idStart = LowerBound(byId, it => it.Id >= selector.Start);
+                var idEnd = LowerBound(byId, it => it.Id > selector.End);
+
+                var xCandidates = 0;
+                var byX = notesByX[type];
+                foreach (var pair in byX)
+                {
+                    if (selector.Direction != null && selector.Direction != pair.Key) continue;
+                    var (xStart, xEnd) = XRange(pair.Value, selector);
+                    xCandidates += Math.Max(0, xEnd - xStart);
+                }
+
+                if (xCandidates < idEnd - idStart)
+                {
+                    foreach (var pair in byX)
+                    {
+                        if (selector.Direction != null && selector.Direction != pair.Key) continue;
+                        var (xStart, xEnd) = XRange(pair.Value, selector);
+                        candidateRanges.Add((pair.Value, xStart, xEnd));
+                    }
+                    candidates += xCandidates;
+                }
+                else
+                {
+                    candidateRanges.Add((byId, idStart, idEnd));
+                    candidates += idEnd - idStart;
+                }
+            }
+
+            if (candidates * LinearScanRatio >= allNotes.Length)
+            {
+                result = new List<int>();
+                foreach (var note in allNotes)
+                {
+                    if (selector.Types.Contains(note.Type) && Matches(note, selector)) result.Add(note.Id);
+                }
+                results[key] = result;
+                return result;
+            }
+
+            matches.Clear();
+            foreach (var (notes, start, end) in candidateRanges)
+            {
+                for (var i = start; i < end; i++)
+                {
+                    if (Matches(notes[i], selector)) matches.Add(notes[i]);
+                }
+            }
+
+            matches.Sort(OrderComparer);
+            result = new List<int>(matches.Count);
+            foreach (var note in matches) result.Add(note.Id);
+            results[key] = result;
+            return result;
+        }
+
+        private static bool Matches(IndexedNote note, NoteSelector selector)
+        {
+            return selector.Start <= note.Id
+                   && selector.End >= note.Id
+                   && selector.MinX <= note.X
+                   && selector.MaxX >= note.X
+                   && (selector.Direction == null || selector.Direction == note.Direction);
+        }
+
+        private static (int, int) XRange(IndexedNote[] notes, NoteSelector selector)
+        {
+            return (LowerBound(notes, it => selector.MinX <= it.X), LowerBound(notes, it => selector.MaxX < it.X));
+        }
+
+        /**
+         * Returns the index of the first note that satisfies the predicate, which must be monotonic over the notes.
+         */
+        private static int LowerBound(IndexedNote[] notes, Func<IndexedNote, bool> predicate)
+        {
+            int low = 0, high = notes.Length;
+            while (low < high)
+            {
+                var mid = (low + high) / 2;
+                if (predicate(notes[mid])) high = mid;
+                else low = mid + 1;
+            }
+            return low;
+        }
+
+        private static string CreateKey(NoteSelector selector)
+        {
+            var types = new List<int>(selector.Types);
+            types.Sort();
+            return string.Join(",", types) + "|" + selector.Start + "|" + selector.End + "|" + selector.Direction + "|" +
+                   selector.MinX.ToString("R", CultureInfo.InvariantCulture) + "|" +
+                   selector.MaxX.ToString("R", CultureInfo.InvariantCulture);
+        }
+    }
+}
@@ -98,6 +98,7 @@ namespace Cytoid.Storyboard.Notes
                 {
                     Note.Override.RingColor = null;
                 }
+                Note.Override.Version++;
             }
 
             if (From.OverrideFillColor != null)
@@ -110,6 +111,7 @@ namespace Cytoid.Storyboard.Notes
                 {
                     Note.Override.FillColor = null;
                 }
+                Note.Override.Version++;
             }
 
             if (From.OpacityMultiplier != null)
@@ -120,11 +122,13 @@ namespace Cytoid.Storyboard.Notes
             if (From.SizeMultiplier != null)
             {
                 Note.Override.SizeMultiplier = EaseFloat(From.SizeMultiplier, To.SizeMultiplier);
+                Note.Override.Version++;
             }
             
             if (From.HitboxMultiplier != null)
             {
                 Note.Override.HitboxMultiplier = EaseFloat(From.HitboxMultiplier, To.HitboxMultiplier);
+                Note.Override.Version++;
             }
 
             if (From.XMultiplier != null)
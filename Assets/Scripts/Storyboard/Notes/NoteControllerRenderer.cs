@@ -14,6 +14,8 @@ namespace Cytoid.Storyboard.Sprites
         
         public override bool IsOnCanvas => false;
 
+        public override bool UpdatesAfterLastState => true; // Follows the note
+
         private Transform notePlaceholderTransform;
         private GameObject noteGameObject;
         
@@ -29,7 +31,7 @@ namespace Cytoid.Storyboard.Sprites
             
             var note = Component.States[0].Note;
             if (note == null) throw new ArgumentNullException();
-            if (!MainRenderer.Game.Chart.Model.note_map.ContainsKey(note.Value)) throw new ArgumentException($"Storyboard: Note {note.Value} does not exist");
+            if (!MainRenderer.Game.Chart.Model.HasNote(note.Value)) throw new ArgumentException($"Storyboard: Note {note.Value} does not exist");
             
             Note = MainRenderer.Game.Chart.Model.note_map[note.Value];
 
@@ -1,5 +1,4 @@
 using Newtonsoft.Json.Linq;
-using UnityEngine;
 
 namespace Cytoid.Storyboard.Notes
 {
@@ -36,10 +35,10 @@ namespace Cytoid.Storyboard.Notes
             state.RotZ = (float?) json.SelectToken("rot_z") ?? state.RotZ;
             
             state.OverrideRingColor = (bool?) json.SelectToken("override_ring_color") ?? state.OverrideRingColor;
-            if (ColorUtility.TryParseHtmlString((string) json.SelectToken("ring_color"), out var tmp))
+            if (TryParseHtmlString((string) json.SelectToken("ring_color"), out var tmp))
                 state.RingColor = new Color {R = tmp.r, G = tmp.g, B = tmp.b, A = tmp.a};
             state.OverrideFillColor = (bool?) json.SelectToken("override_fill_color") ?? state.OverrideFillColor;
-            if (ColorUtility.TryParseHtmlString((string) json.SelectToken("fill_color"), out var tmp2))
+            if (TryParseHtmlString((string) json.SelectToken("fill_color"), out var tmp2))
                 state.FillColor = new Color {R = tmp2.r, G = tmp2.g, B = tmp2.b, A = tmp2.a};
             state.OpacityMultiplier = (float?) json.SelectToken("opacity_multiplier") ?? state.OpacityMultiplier;
             state.SizeMultiplier = (float?) json.SelectToken("size_multiplier") ?? state.SizeMultiplier;
@@ -1,5 +1,4 @@
 using Newtonsoft.Json.Linq;
-using UnityEngine;
 
 namespace Cytoid.Storyboard.Sprites
 {
@@ -15,7 +14,7 @@ namespace Cytoid.Storyboard.Sprites
 
             state.Path = (string) json.SelectToken("path") ?? state.Path;
             state.PreserveAspect = (bool?) json.SelectToken("preserve_aspect") ?? state.PreserveAspect;
-            if (ColorUtility.TryParseHtmlString((string) json.SelectToken("color"), out var tmp))
+            if (TryParseHtmlString((string) json.SelectToken("color"), out var tmp))
                 state.Color = new Color {R = tmp.r, G = tmp.g, B = tmp.b, A = tmp.a};
         }
     }
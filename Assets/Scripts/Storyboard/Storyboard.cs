@@ -22,6 +22,8 @@ namespace Cytoid.Storyboard
         public StoryboardConfig Config { get; }
         
         public readonly JObject RootObject;
+
+        private readonly CompiledStoryboard compiledStoryboard;
         
         public readonly Dictionary<string, Text> Texts = new Dictionary<string, Text>();
         public readonly Dictionary<string, Sprite> Sprites = new Dictionary<string, Sprite>();
@@ -33,25 +35,54 @@ namespace Cytoid.Storyboard
         
         public readonly Dictionary<string, JObject> Templates = new Dictionary<string, JObject>();
 
-        public Storyboard(Game game, string content)
+        public Storyboard(Game game, string content) : this(game, JObject.Parse(content))
+        {
+        }
+
+        /**
+         * Creates a storyboard from an already parsed root object, e.g. one parsed off the main thread.
+         */
+        public Storyboard(Game game, JObject rootObject)
         {
             Game = game;
             Renderer = new StoryboardRenderer(this);
             Config = new StoryboardConfig(this);
             
             UnitFloat.Storyboard = this;
-            RootObject = JObject.Parse(content);
+            RootObject = rootObject;
             /*JsonConvert.DefaultSettings = () => new JsonSerializerSettings
             {
                 ReferenceLoopHandling = ReferenceLoopHandling.Ignore
             };*/ // Moved to Context.cs
         }
 
+        /**
+         * Creates a storyboard from a binary compiled storyboard (see Compile).
+         */
+        public Storyboard(Game game, CompiledStoryboard compiledStoryboard)
+        {
+            Game = game;
+            Renderer = new StoryboardRenderer(this);
+            Config = new StoryboardConfig(this);
+
+            UnitFloat.Storyboard = this;
+            this.compiledStoryboard = compiledStoryboard;
+        }
+
         public void Parse()
         {
-            if ((bool?) RootObject["compiled"] == true)
+            if (compiledStoryboard != null)
+            {
+                compiledStoryboard.Texts.ForEach(it => Texts[it.Id] = it);
+                compiledStoryboard.Sprites.ForEach(it => Sprites[it.Id] = it);
+                compiledStoryboard.Videos.ForEach(it => Videos[it.Id] = it);
+                compiledStoryboard.Lines.ForEach(it => Lines[it.Id] = it);
+                compiledStoryboard.Controllers.ForEach(it => Controllers[it.Id] = it);
+                compiledStoryboard.NoteControllers.ForEach(it => NoteControllers[it.Id] = it);
+            }
+            else if ((bool?) RootObject["compiled"] == true)
             {
-                // Directly load into memory
+                // Compiled JSON, written by earlier versions: directly load into memory
                 ((JArray) RootObject["texts"]).Select(it => it.ToObject<Text>()).ForEach(it => Texts[it.Id] = it);
                 ((JArray) RootObject["sprites"]).Select(it => it.ToObject<Sprite>()).ForEach(it => Sprites[it.Id] = it);
                 ((JArray) RootObject["videos"]).Select(it => it.ToObject<Video>()).ForEach(it => Videos[it.Id] = it);
@@ -183,33 +214,13 @@ namespace Cytoid.Storyboard
             }
         }
 
-        public JObject Compile()
+        /**
+         * Writes the parsed objects in the binary compiled format (see CompiledStoryboard). As with the compiled JSON
+         * format it replaces, triggers are not included.
+         */
+        public void Compile(Stream stream)
         {
-            var serializer = new JsonSerializer
-            {
-                NullValueHandling = NullValueHandling.Ignore
-            };
-            var root = new JObject();
-            root["compiled"] = true;
-            var texts = new JArray();
-            Texts.Values.ForEach(it => texts.Add(JObject.FromObject(it, serializer)));
-            root["texts"] = texts;
-            var sprites = new JArray();
-            Sprites.Values.ForEach(it => sprites.Add(JObject.FromObject(it, serializer)));
-            root["sprites"] = sprites;
-            var videos = new JArray();
-            Videos.Values.ForEach(it => videos.Add(JObject.FromObject(it, serializer)));
-            root["videos"] = videos;
-            var lines = new JArray();
-            Lines.Values.ForEach(it => lines.Add(JObject.FromObject(it, serializer)));
-            root["lines"] = lines;
-            var controllers = new JArray();
-            Controllers.Values.ForEach(it => controllers.Add(JObject.FromObject(it, serializer)));
-            root["controllers"] = controllers;
-            var noteControllers = new JArray();
-            NoteControllers.Values.ForEach(it => noteControllers.Add(JObject.FromObject(it, serializer)));
-            root["note_controllers"] = noteControllers;
-            return root;
+            CompiledStoryboard.Write(this, stream);
         }
 
         private void RecursivelyParseTime(JObject obj)
@@ -253,125 +264,115 @@ namespace Cytoid.Storyboard
             }
         }
 
+        private static readonly string[] TimeArrayKeys = {"relative_time", "add_time", "time"};
+
         /**
-         * Convert an object with an array of `time` to multiple objects.
+         * Convert an object with an array of `time` (or `relative_time`, `add_time`) and/or a note specifier to
+         * multiple objects. To avoid cloning obj for every time and note, all objects are the same working copy with
+         * only these properties replaced; each yielded object must therefore be consumed before moving to the next.
          */
-        private List<JObject> PopulateJObjects(JObject obj)
+        private IEnumerable<JObject> PopulateJObjects(JObject obj)
         {
-            var timePopulatedObjects = new List<JObject>();
+            var noteSpecifierToken = obj.SelectToken("note");
+            var noteIds = noteSpecifierToken != null ? SelectNotes(noteSpecifierToken) : null;
+            var hasTimeArray = TimeArrayKeys.Any(it => obj[it] is JArray array && array.Count > 0);
 
-            var timeToken = obj.SelectToken("relative_time");
-            if (timeToken != null && timeToken.Type == JTokenType.Array)
-                foreach (var time in timeToken.Values())
-                {
-                    var newObj = (JObject) obj.DeepClone();
-                    newObj["relative_time"] = time;
-                    timePopulatedObjects.Add(newObj);
-                }
+            if (!hasTimeArray && noteIds == null)
+            {
+                yield return obj;
+                yield break;
+            }
 
-            timeToken = obj.SelectToken("add_time");
-            if (timeToken != null && timeToken.Type == JTokenType.Array)
-                foreach (var time in timeToken.Values())
+            var populatedObj = (JObject) obj.DeepClone();
+
+            if (!hasTimeArray)
+            {
+                foreach (var noteId in noteIds)
                 {
-                    var newObj = (JObject) obj.DeepClone();
-                    newObj["add_time"] = time;
-                    timePopulatedObjects.Add(newObj);
+                    populatedObj["note"] = noteId;
+                    yield return populatedObj;
                 }
+                yield break;
+            }
+
+            foreach (var timeKey in TimeArrayKeys)
+            {
+                var timeToken = obj[timeKey];
+                if (timeToken == null || timeToken.Type != JTokenType.Array) continue;
 
-            timeToken = obj.SelectToken("time");
-            if (timeToken != null && timeToken.Type == JTokenType.Array)
                 foreach (var time in timeToken.Values())
                 {
-                    var newObj = (JObject) obj.DeepClone();
-                    newObj["time"] = time;
-                    timePopulatedObjects.Add(newObj);
+                    populatedObj[timeKey] = time;
+                    if (noteIds == null)
+                    {
+                        yield return populatedObj;
+                        continue;
+                    }
+                    foreach (var noteId in noteIds)
+                    {
+                        populatedObj["note"] = noteId;
+                        yield return populatedObj;
+                    }
                 }
 
-            timePopulatedObjects = timePopulatedObjects.Count == 0 ? new List<JObject> {obj} : timePopulatedObjects;
-
-            var populatedObjects = new List<JObject>();
+                // Objects populated from the other time arrays keep this one as is
+                populatedObj[timeKey] = timeToken;
+            }
+        }
 
-            foreach (var obj2 in timePopulatedObjects)
+        /**
+         * Returns the ids of the notes matched by a note specifier: a note selector object, an array of note ids or a
+         * single note id. The returned list must not be modified.
+         */
+        private List<int> SelectNotes(JToken noteSpecifierToken)
+        {
+            if (noteSpecifierToken.Type == JTokenType.Object)
             {
-                var noteSpecifierToken = obj.SelectToken("note");
-                if (noteSpecifierToken != null)
+                // Note selector
+                var noteSelector = new NoteSelector();
+                noteSelector.Start = (int?) noteSpecifierToken.SelectToken("start") ?? noteSelector.Start;
+                noteSelector.End = (int?) noteSpecifierToken.SelectToken("end") ?? noteSelector.End;
+                noteSelector.Direction = (int?) noteSpecifierToken.SelectToken("direction") ?? noteSelector.Direction;
+                noteSelector.MinX = (float?) noteSpecifierToken.SelectToken("min_x") ?? noteSelector.MinX;
+                noteSelector.MaxX = (float?) noteSpecifierToken.SelectToken("max_x") ?? noteSelector.MaxX;
+                var typeToken = noteSpecifierToken.SelectToken("type");
+                if (typeToken != null)
                 {
-                    if (noteSpecifierToken.Type == JTokenType.Object)
+                    if (typeToken.Type == JTokenType.Integer)
                     {
-                        // Note selector
-                        var noteSelector = new NoteSelector();
-                        noteSelector.Start = (int?) noteSpecifierToken.SelectToken("start") ?? noteSelector.Start;
-                        noteSelector.End = (int?) noteSpecifierToken.SelectToken("end") ?? noteSelector.End;
-                        noteSelector.Direction = (int?) noteSpecifierToken.SelectToken("direction") ?? noteSelector.Direction;
-                        noteSelector.MinX = (float?) noteSpecifierToken.SelectToken("min_x") ?? noteSelector.MinX;
-                        noteSelector.MaxX = (float?) noteSpecifierToken.SelectToken("max_x") ?? noteSelector.MaxX;
-                        var typeToken = noteSpecifierToken.SelectToken("type");
-                        if (typeToken != null)
-                        {
-                            if (typeToken.Type == JTokenType.Integer)
-                            {
-                                noteSelector.Types.Add((int) typeToken);
-                            }
-                            else if (typeToken.Type == JTokenType.Array)
-                            {
-                                foreach (var noteToken in typeToken.Values())
-                                {
-                                    noteSelector.Types.Add((int) noteToken);
-                                }
-                            }
-                        }
-                        else
-                        {
-                            ((NoteType[]) Enum.GetValues(typeof(NoteType))).ForEach(it =>
-                                noteSelector.Types.Add((int) it));
-                        }
-
-                        var noteIds = new List<int>();
-                        foreach (var chartNote in Game.Chart.Model.note_list)
-                        {
-                            if (noteSelector.Types.Contains(chartNote.type)
-                                && noteSelector.Start <= chartNote.id
-                                && noteSelector.End >= chartNote.id
-                                && noteSelector.MinX <= chartNote.x
-                                && noteSelector.MaxX >= chartNote.x)
-                            {
-                                if (noteSelector.Direction == null || noteSelector.Direction == chartNote.direction)
-                                {
-                                    noteIds.Add(chartNote.id);
-                                }
-                            }
-                        }
-
-                        foreach (var noteId in noteIds)
-                        {
-                            var newObj = (JObject) obj2.DeepClone();
-                            newObj["note"] = noteId;
-                            populatedObjects.Add(newObj);
-                        }
-                    } 
-                    else if (noteSpecifierToken.Type == JTokenType.Array)
+                        noteSelector.Types.Add((int) typeToken);
+                    }
+                    else if (typeToken.Type == JTokenType.Array)
                     {
-                        foreach (var noteToken in noteSpecifierToken.Values())
+                        foreach (var noteToken in typeToken.Values())
                         {
-                            var newObj = (JObject) obj2.DeepClone();
-                            newObj["note"] = (int) noteToken;
-                            populatedObjects.Add(newObj);
+                            noteSelector.Types.Add((int) noteToken);
                         }
                     }
-                    else if (noteSpecifierToken.Type == JTokenType.Integer)
-                    {
-                        var newObj = (JObject) obj2.DeepClone();
-                        newObj["note"] = (int) noteSpecifierToken;
-                        populatedObjects.Add(newObj);
-                    }
                 }
                 else
                 {
-                    populatedObjects.Add(obj2);
+                    ((NoteType[]) Enum.GetValues(typeof(NoteType))).ForEach(it =>
+                        noteSelector.Types.Add((int) it));
                 }
+
+                if (noteSelectorIndex == null) noteSelectorIndex = new NoteSelectorIndex(Game.Chart.Model.note_list);
+                return noteSelectorIndex.Select(noteSelector);
             }
 
-            return populatedObjects;
+            var noteIds = new List<int>();
+            if (noteSpecifierToken.Type == JTokenType.Array)
+            {
+                foreach (var noteToken in noteSpecifierToken.Values())
+                {
+                    noteIds.Add((int) noteToken);
+                }
+            }
+            else if (noteSpecifierToken.Type == JTokenType.Integer)
+            {
+                noteIds.Add((int) noteSpecifierToken);
+            }
+            return noteIds;
         }
 
         private Trigger LoadTrigger(JToken token)
@@ -395,10 +396,13 @@ namespace Cytoid.Storyboard
             return trigger;
         }
 
-        private TO LoadObject<TO, TS>(JToken token) where TO : Object<TS>, new() where TS : ObjectState, new()
+        private TO LoadObject<TO, TS>(JObject obj) where TO : Object<TS>, new() where TS : ObjectState, new()
         {
+            // Populated objects have a single note id (see PopulateJObjects)
+            var noteToken = obj["note"];
+            if (noteToken != null && noteToken.Type == JTokenType.Integer) replacements["note"] = (int) noteToken;
+
             var states = new List<TS>();
-            var obj = token.ToObject<JObject>();
 
             // Create initial state
             var initialState = (TS) CreateState((TS) null, obj);
@@ -413,11 +417,11 @@ namespace Cytoid.Storyboard
 
                 // Template has states?
                 if (templateObject["states"] != null)
-                    AddStates(states, initialState, templateObject, ParseTime(obj, obj.SelectToken("time")));
+                    AddStates(states, initialState, templateObject, templateObject["states"], ParseTime(obj, obj.SelectToken("time")));
             }
 
             // Create inline states
-            AddStates(states, initialState, obj, ParseTime(obj, obj.SelectToken("time")));
+            AddStates(states, initialState, obj, obj["states"], ParseTime(obj, obj.SelectToken("time")));
 
             var id = (string) obj["id"] ?? Path.GetRandomFileName();
             var targetId = (string) obj.SelectToken("target_id");
@@ -438,30 +442,24 @@ namespace Cytoid.Storyboard
             };
         }
 
-        private void AddStates<TS>(List<TS> states, TS baseState, JObject rootObject, float? rootBaseTime)
+        private void AddStates<TS>(List<TS> states, TS baseState, JObject rootObject, JToken statesToken, float? rootBaseTime)
             where TS : ObjectState, new()
         {
             var baseTime = ParseTime(rootObject, rootObject.SelectToken("time")) ?? rootBaseTime ?? float.MaxValue; // We set this to float.MaxValue, so if time is not set, the object is not displayed
 
-            if (rootObject["states"] != null && rootObject["states"].Type != JTokenType.Null)
+            if (statesToken != null && statesToken.Type != JTokenType.Null)
             {
                 var lastTime = baseTime;
 
-                var allStates = new JArray();
-                foreach (var childToken in (JArray) rootObject["states"])
+                foreach (var stateObject in ((JArray) statesToken).SelectMany(it => PopulateJObjects((JObject) it)))
                 {
-                    var populatedChildren = PopulateJObjects((JObject) childToken);
-                    foreach (var child in populatedChildren) allStates.Add(child);
-                }
-
-                foreach (var stateJson in allStates)
-                {
-                    var stateObject = stateJson.ToObject<JObject>();
                     var objectState = CreateState(baseState, stateObject);
+                    var templateObject = GetTemplate(stateObject);
 
                     if (objectState.Time != float.MaxValue) baseTime = objectState.Time;
 
-                    var relativeTime = (float?) stateObject["relative_time"];
+                    // Relative time, add time and inline states may be put by the template
+                    var relativeTime = (float?) (stateObject["relative_time"] ?? templateObject?["relative_time"]);
 
                     if (relativeTime != null)
                     {
@@ -470,7 +468,7 @@ namespace Cytoid.Storyboard
                         objectState.Time = baseTime + (float) relativeTime;
                     }
 
-                    var addTime = (float?) stateObject["add_time"];
+                    var addTime = (float?) (stateObject["add_time"] ?? templateObject?["add_time"]);
 
                     if (addTime != null)
                     {
@@ -485,7 +483,8 @@ namespace Cytoid.Storyboard
                     lastTime = objectState.Time;
 
                     // Add inline states
-                    if (stateObject["states"] != null) AddStates(states, baseState, stateObject, rootBaseTime);
+                    var inlineStatesToken = stateObject["states"] ?? templateObject?["states"];
+                    if (inlineStatesToken != null) AddStates(states, baseState, stateObject, inlineStatesToken, rootBaseTime);
                 }
             }
         }
@@ -495,24 +494,7 @@ namespace Cytoid.Storyboard
             if ((bool?) stateObject["reset"] == true) baseState = null; // Allow resetting states
 
             // Load template
-            JObject templateObject = null;
-            if (stateObject["template"] != null)
-            {
-                var templateId = (string) stateObject["template"];
-                templateObject = Templates[templateId];
-
-                if (templateObject != null)
-                {
-                    // Put relative time and add time
-                    if (stateObject["relative_time"] == null)
-                        stateObject["relative_time"] = templateObject["relative_time"];
-
-                    if (stateObject["add_time"] == null) stateObject["add_time"] = templateObject["add_time"];
-
-                    // Put template states
-                    if (stateObject["states"] == null) stateObject["states"] = templateObject["states"];
-                }
-            }
+            var templateObject = GetTemplate(stateObject);
 
             var parser = CreateStateParser(typeof(TS));
             
@@ -523,6 +505,17 @@ namespace Cytoid.Storyboard
             return state;
         }
 
+        /**
+         * Templates are shared by all objects that use them, so they are only read: the relative time, add time and
+         * states of a template are looked up by AddStates instead of being put into the state object.
+         */
+        private JObject GetTemplate(JObject stateObject)
+        {
+            return stateObject["template"] != null ? Templates[(string) stateObject["template"]] : null;
+        }
+
+        private NoteSelectorIndex noteSelectorIndex;
+
         private readonly Dictionary<string, object> replacements = new Dictionary<string, object>();
 
         public float? ParseTime(JObject obj, JToken token)
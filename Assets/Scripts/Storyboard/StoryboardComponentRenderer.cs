@@ -12,6 +12,14 @@ namespace Cytoid.Storyboard
         public List<StoryboardComponentRenderer> Children = new List<StoryboardComponentRenderer>();
 
         public StoryboardComponentRenderer Parent;
+
+        public int StateCursor; // See Object.FindStates
+
+        /**
+         * Whether the renderer has to be updated every frame after its last state, because it depends on more than its
+         * states. Otherwise StoryboardRenderer stops updating it once its last state has been applied.
+         */
+        public virtual bool UpdatesAfterLastState => false;
         
         public abstract Transform Transform { get; }
         
@@ -1,6 +1,5 @@
 using System;
 using System.Collections.Generic;
-using System.Linq;
 using Newtonsoft.Json;
 
 namespace Cytoid.Storyboard
@@ -14,7 +13,28 @@ namespace Cytoid.Storyboard
 
         public abstract bool IsManuallySpawned();
 
-        public abstract void FindStates(float time, out ObjectState currentState, out ObjectState nextState);
+        /**
+         * Time from which FindStates returns a current state, or float.MaxValue if the object has no states.
+         */
+        [JsonIgnore] public abstract float FirstStateTime { get; }
+
+        /**
+         * Time after which FindStates always returns the last state.
+         */
+        [JsonIgnore] public abstract float LastStateTime { get; }
+
+        public void FindStates(float time, out ObjectState currentState, out ObjectState nextState)
+        {
+            var cursor = 0;
+            FindStates(time, ref cursor, out currentState, out nextState);
+        }
+
+        /**
+         * Finds the current and next state at the given time, starting from a cursor left by the previous lookup (the
+         * index of the next state). Lookups with non-decreasing times only advance the cursor; if the time has moved
+         * backwards (e.g. seeking in PlayerGame), it is repositioned with a binary search.
+         */
+        public abstract void FindStates(float time, ref int cursor, out ObjectState currentState, out ObjectState nextState);
     }
 
     [Serializable]
@@ -27,27 +47,46 @@ namespace Cytoid.Storyboard
             return States[0].Time == float.MaxValue;
         }
 
-        public override void FindStates(float time, out ObjectState currentState, out ObjectState nextState)
-        {
-            // TODO: Offline lookup generation?
+        [JsonIgnore] public override float FirstStateTime => States.Count > 0 ? States[0].Time : float.MaxValue;
+
+        [JsonIgnore] public override float LastStateTime => States.Count > 0 ? States[States.Count - 1].Time : float.MaxValue;
 
-            if (States.Count == 0)
+        public override void FindStates(float time, ref int cursor, out ObjectState currentState, out ObjectState nextState)
+        {
+            var count = States.Count;
+            if (count == 0)
             {
                 currentState = null;
                 nextState = null;
                 return;
             }
 
-            for (var i = 0; i < States.Count; i++)
-                if (States[i].Time > time) // Next state
+            // States are sorted by time (see Storyboard.LoadObject)
+            cursor = Math.Max(0, Math.Min(cursor, count));
+            if (cursor > 0 && States[cursor - 1].Time > time)
+            {
+                // Time has moved backwards; find the first state after time
+                var low = 0;
+                var high = cursor - 1;
+                while (low < high)
                 {
-                    // Current state is the previous state
-                    currentState = i > 0 ? States[i - 1] : null;
-                    nextState = States[i];
-                    return;
+                    var middle = (low + high) / 2;
+                    if (States[middle].Time > time) high = middle;
+                    else low = middle + 1;
                 }
+                cursor = low;
+            }
+            while (cursor < count && States[cursor].Time <= time) cursor++;
+
+            if (cursor < count) // Next state
+            {
+                // Current state is the previous state
+                currentState = cursor > 0 ? States[cursor - 1] : null;
+                nextState = States[cursor];
+                return;
+            }
 
-            currentState = nextState = States.Last();
+            currentState = nextState = States[count - 1];
         }
     }
 
@@ -33,6 +33,38 @@ namespace Cytoid.Storyboard
         public readonly Dictionary<string, int> SpritePathRefCount = new Dictionary<string, int>();
         
         public StoryboardConstants Constants { get; } = new StoryboardConstants();
+
+        private static readonly Type[] UpdateOrder =
+            {typeof(NoteController), typeof(Text), typeof(Sprite), typeof(Line), typeof(Video), typeof(Controller)};
+
+        private static readonly IComparer<ScheduledGroup> GroupOrderComparer =
+            Comparer<ScheduledGroup>.Create((a, b) => a.Order.CompareTo(b.Order));
+
+        private class ScheduledRenderer
+        {
+            public StoryboardComponentRenderer Renderer;
+            public float StartTime;
+            public float EndTime; // float.MaxValue if the renderer updates after its last state
+            public ScheduledGroup Group;
+            public bool IsStarted;
+            public bool IsSettled;
+        }
+
+        private class ScheduledGroup
+        {
+            public readonly List<ScheduledRenderer> Renderers = new List<ScheduledRenderer>(); // In update order
+            public int Order; // Update order of the first renderer
+            public int ChangingCount; // Started and not settled
+            public int SettledFrames; // Frames updated since every started renderer settled
+            public bool IsActive;
+        }
+
+        private readonly List<ScheduledRenderer> scheduledRenderers = new List<ScheduledRenderer>(); // By start time
+        private readonly List<ScheduledGroup> activeGroups = new List<ScheduledGroup>(); // By order
+        private readonly Dictionary<string, Type> renderersToDestroy = new Dictionary<string, Type>();
+        private int nextStartIndex;
+        private bool isScheduleDirty = true;
+        private float lastUpdateTime;
         
         public class StoryboardConstants
         {
@@ -50,6 +82,7 @@ namespace Cytoid.Storyboard
         public void Clear()
         {
             ComponentRenderers.Values.ForEach(it => it.Clear());
+            isScheduleDirty = true;
 
             ResetCamera();
             ResetCameraFilters();
@@ -270,6 +303,7 @@ namespace Cytoid.Storyboard
                 
                 tasks.Add(renderer.Initialize());
             }
+            isScheduleDirty = true;
 
             await UniTask.WhenAll(tasks);
             return renderers;
@@ -279,18 +313,45 @@ namespace Cytoid.Storyboard
         {
             var time = Time;
             if (time < 0 || Game.State.IsReadyToExit) return;
+            UpdateRenderers(time);
+        }
+
+        /**
+         * Updates the renderers that can still change at the given time and destroys the renderers that reached a
+         * destroy state. Renderers are updated group by group (see BuildSchedule); within a group they keep the type
+         * order of UpdateOrder.
+         */
+        public void UpdateRenderers(float time)
+        {
+            if (isScheduleDirty) BuildSchedule();
+            else if (time < lastUpdateTime) RewindSchedule(time);
+            lastUpdateTime = time;
 
-            var updateOrder = new[]
-                {typeof(NoteController), typeof(Text), typeof(Sprite), typeof(Line), typeof(Video), typeof(Controller)};
+            // Start renderers whose first state has been reached
+            while (nextStartIndex < scheduledRenderers.Count && scheduledRenderers[nextStartIndex].StartTime <= time)
+            {
+                var scheduledRenderer = scheduledRenderers[nextStartIndex++];
+                scheduledRenderer.IsStarted = true;
+                var group = scheduledRenderer.Group;
+                group.ChangingCount++;
+                group.SettledFrames = 0;
+                if (!group.IsActive)
+                {
+                    group.IsActive = true;
+                    activeGroups.Insert(~activeGroups.BinarySearch(group, GroupOrderComparer), group);
+                }
+            }
 
-            var renderersToDestroy = new Dictionary<string, Type>();
+            renderersToDestroy.Clear();
 
-            foreach (var type in updateOrder)
+            foreach (var group in activeGroups)
             {
-                var renderers = TypedComponentRenderers[type];
-                foreach (var renderer in renderers)
+                foreach (var scheduledRenderer in group.Renderers)
                 {
-                    renderer.Component.FindStates(time, out var fromState, out var toState);
+                    if (!scheduledRenderer.IsStarted) continue;
+                    var renderer = scheduledRenderer.Renderer;
+
+                    renderer.Component.FindStates(time, ref renderer.StateCursor, out var fromState, out var toState);
 
                     if (fromState == null) continue;
 
@@ -300,10 +361,10 @@ namespace Cytoid.Storyboard
                         // Destroy the target as well
                         if (renderer.Parent != null && renderer.Component.TargetId != null)
                         {
-                            renderersToDestroy[renderer.Parent.Component.Id] = type;
+                            renderersToDestroy[renderer.Parent.Component.Id] = renderer.Parent.Component.GetType();
                             this.ListOf(renderer.Parent).Flatten(it => it.Children).ForEach(it =>
                             {
-                                renderersToDestroy[it.Component.Id] = type;
+                                renderersToDestroy[it.Component.Id] = it.Component.GetType();
                             });
                         }
                         else
@@ -311,17 +372,34 @@ namespace Cytoid.Storyboard
                             renderer.Parent?.Children.Remove(renderer);
                             this.ListOf(renderer).Flatten(it => it.Children).ForEach(it =>
                             {
-                                renderersToDestroy[it.Component.Id] = type;
+                                renderersToDestroy[it.Component.Id] = it.Component.GetType();
                             });
                         }
                         continue;
                     }
 
                     renderer.Update(fromState, toState);
+
+                    if (!scheduledRenderer.IsSettled && time >= scheduledRenderer.EndTime)
+                    {
+                        // The last state has been applied; nothing changes until the schedule is rebuilt
+                        scheduledRenderer.IsSettled = true;
+                        group.ChangingCount--;
+                    }
                 }
+                if (group.ChangingCount == 0) group.SettledFrames++;
+            }
+            for (var i = activeGroups.Count - 1; i >= 0; i--)
+            {
+                // Update a settled group once more, for equivalent transforms that read positions written later in the
+                // frame they settled in
+                if (activeGroups[i].SettledFrames < 2) continue;
+                activeGroups[i].IsActive = false;
+                activeGroups.RemoveAt(i);
             }
 
-            renderersToDestroy.ForEach(it =>
+            if (renderersToDestroy.Count == 0) return;
+            foreach (var it in renderersToDestroy)
             {
                 var id = it.Key;
                 var type = it.Value;
@@ -337,7 +415,116 @@ namespace Cytoid.Storyboard
                 }
                 ComponentRenderers.Remove(id);
                 TypedComponentRenderers[type].Remove(renderer);
-            });
+            }
+            isScheduleDirty = true;
+        }
+
+        /**
+         * Orders the renderers by the time of their first state. Renderers connected by target_id or parent_id may
+         * write to the same transforms, so they are grouped and always updated together in update order; a group is
+         * only updated while one of its started renderers has not applied its last state yet (or updates after it).
+         * Groups are updated in the order of their first renderer rather than type by type, so e.g. a sprite may be
+         * updated before a text of another group. Unconnected renderers write to different transforms, so this does not
+         * change the result; controllers, which write to the shared camera, keep their relative order as long as they
+         * are not connected to other objects.
+         * The schedule is rebuilt whenever renderers are spawned, destroyed or cleared (which is how PlayerGame seeks);
+         * other backward steps in time, such as Game.SynchronizeMusic snapping to the audio clock, are handled by
+         * RewindSchedule.
+         */
+        private void BuildSchedule()
+        {
+            isScheduleDirty = false;
+            scheduledRenderers.Clear();
+            activeGroups.Clear();
+            nextStartIndex = 0;
+
+            var scheduledRenderersById = new Dictionary<string, ScheduledRenderer>();
+            var groupRoots = new Dictionary<ScheduledRenderer, ScheduledRenderer>();
+
+            ScheduledRenderer FindRoot(ScheduledRenderer it)
+            {
+                while (groupRoots[it] != it) it = groupRoots[it] = groupRoots[groupRoots[it]];
+                return it;
+            }
+
+            void Connect(ScheduledRenderer it, string otherId)
+            {
+                if (otherId == null || !scheduledRenderersById.TryGetValue(otherId, out var other)) return;
+                var root = FindRoot(it);
+                var otherRoot = FindRoot(other);
+                if (root != otherRoot) groupRoots[otherRoot] = root;
+            }
+
+            foreach (var type in UpdateOrder)
+            {
+                foreach (var renderer in TypedComponentRenderers[type])
+                {
+                    var component = renderer.Component;
+                    var scheduledRenderer = new ScheduledRenderer
+                    {
+                        Renderer = renderer,
+                        StartTime = component.FirstStateTime,
+                        EndTime = renderer.UpdatesAfterLastState ? float.MaxValue : component.LastStateTime
+                    };
+                    scheduledRenderers.Add(scheduledRenderer);
+                    scheduledRenderersById[component.Id] = scheduledRenderer;
+                    groupRoots[scheduledRenderer] = scheduledRenderer;
+                }
+            }
+            foreach (var it in scheduledRenderers)
+            {
+                Connect(it, it.Renderer.Component.TargetId);
+                Connect(it, it.Renderer.Component.ParentId);
+            }
+
+            var groups = new Dictionary<ScheduledRenderer, ScheduledGroup>();
+            for (var i = 0; i < scheduledRenderers.Count; i++)
+            {
+                var it = scheduledRenderers[i];
+                var root = FindRoot(it);
+                if (!groups.TryGetValue(root, out var group))
+                {
+                    groups[root] = group = new ScheduledGroup {Order = i};
+                }
+                group.Renderers.Add(it);
+                it.Group = group;
+            }
+
+            scheduledRenderers.Sort((a, b) => a.StartTime.CompareTo(b.StartTime));
+        }
+
+        /**
+         * Moves the schedule back to the given time without rebuilding it: renderers that start after it are stopped
+         * again, and settled renderers that end after it are updated again.
+         */
+        private void RewindSchedule(float time)
+        {
+            var startIndex = nextStartIndex;
+            for (var i = nextStartIndex - 1; i >= 0; i--)
+            {
+                var scheduledRenderer = scheduledRenderers[i];
+                var group = scheduledRenderer.Group;
+                if (scheduledRenderer.StartTime > time)
+                {
+                    // Sorted by start time, so every renderer before it is still started
+                    startIndex = i;
+                    if (!scheduledRenderer.IsSettled) group.ChangingCount--;
+                    scheduledRenderer.IsStarted = false;
+                    scheduledRenderer.IsSettled = false;
+                    continue;
+                }
+                if (!scheduledRenderer.IsSettled || scheduledRenderer.EndTime <= time) continue;
+
+                scheduledRenderer.IsSettled = false;
+                group.ChangingCount++;
+                group.SettledFrames = 0;
+                if (!group.IsActive)
+                {
+                    group.IsActive = true;
+                    activeGroups.Insert(~activeGroups.BinarySearch(group, GroupOrderComparer), group);
+                }
+            }
+            nextStartIndex = startIndex;
         }
 
         public void OnTrigger(Trigger trigger)
@@ -385,9 +572,10 @@ namespace Cytoid.Storyboard
             {
                 if (Game is PlayerGame) it.Clear();
                 else it.Dispose();
-                TypedComponentRenderers[it.GetType()].Remove(it);
+                TypedComponentRenderers[it.Component.GetType()].Remove(it);
             });
             ComponentRenderers.Remove(id);
+            isScheduleDirty = true;
         }
 
         public void RecalculateTime<TO, TS>(TO obj) where TO : Object<TS> where TS : ObjectState
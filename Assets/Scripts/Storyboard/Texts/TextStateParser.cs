@@ -1,6 +1,5 @@
 using System;
 using Newtonsoft.Json.Linq;
-using UnityEngine;
 
 namespace Cytoid.Storyboard.Texts
 {
@@ -15,7 +14,7 @@ namespace Cytoid.Storyboard.Texts
             ParseStageObjectState(state, json, baseState);
 
             state.Font = (string) json.SelectToken("font") ?? state.Font;
-            if (ColorUtility.TryParseHtmlString((string) json.SelectToken("color"), out var tmp))
+            if (TryParseHtmlString((string) json.SelectToken("color"), out var tmp))
                 state.Color = new Color {R = tmp.r, G = tmp.g, B = tmp.b, A = tmp.a};
             state.Text = (string) json.SelectToken("text") ?? state.Text;
             if (state.Text != null && state.Text.StartsWith("[") && state.Text.EndsWith("]"))
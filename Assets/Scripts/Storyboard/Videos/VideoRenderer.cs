@@ -23,6 +23,8 @@ namespace Cytoid.Storyboard.Videos
         public override Transform Transform => RectTransform;
 
         public override bool IsOnCanvas => true;
+
+        public override bool UpdatesAfterLastState => true; // Pauses and resumes with the game
         
         public VideoRenderer(StoryboardRenderer mainRenderer, Video component) : base(mainRenderer, component)
         {
@@ -1,5 +1,4 @@
 using Newtonsoft.Json.Linq;
-using UnityEngine;
 
 namespace Cytoid.Storyboard.Videos
 {
@@ -14,7 +13,7 @@ namespace Cytoid.Storyboard.Videos
             ParseStageObjectState(state, json, baseState);
 
             state.Path = (string) json.SelectToken("path") ?? state.Path;
-            if (ColorUtility.TryParseHtmlString((string) json.SelectToken("color"), out var tmp))
+            if (TryParseHtmlString((string) json.SelectToken("color"), out var tmp))
                 state.Color = new Color {R = tmp.r, G = tmp.g, B = tmp.b, A = tmp.a};
         }
     }